@@ -1,4 +1,4 @@
-QT += core widgets charts
+QT += core widgets charts concurrent
 
 CONFIG += c++17
 CONFIG += qt
@@ -21,6 +21,9 @@ SOURCES += \
     employee.cpp \
     leaveRequest.cpp \
     attendanceRecord.cpp \
+    stringPool.cpp \
+    writeAheadLog.cpp \
+    attendanceFile.cpp \
     DataStructures.cpp
 
 HEADERS += \
@@ -31,6 +34,9 @@ HEADERS += \
     employee.h \
     leaveRequest.h \
     attendanceRecord.h \
+    stringPool.h \
+    writeAheadLog.h \
+    attendanceFile.h \
     DataStructures.h
 
 FORMS += \
@@ -3,29 +3,221 @@
 #include <QTextStream>
 #include <QDir>
 #include <QDebug>
+#include <QSaveFile>
+#include <QHash>
+#include <QStringList>
+#include <QtConcurrent>
+#include <limits>
+#include <memory>
 
 // Initialize static instance
 DataManager* DataManager::instance = nullptr;
 
+
+// ============================================================================
+// UNDO ENTRY ENCODING
+// ============================================================================
+// Every entry starts with its ActionType byte. Add/delete store the whole
+// employee (needed to re-add it); an edit stores only the fields that
+// changed, old and new value; a leave decision stores the request key and
+// the previous status.
+
+// Field bits of an EDIT_EMPLOYEE entry
+enum EmployeeField : quint8 {
+    FieldName = 1,
+    FieldDepartment = 2,
+    FieldSalary = 4,
+    FieldPosition = 8,
+    FieldPassword = 16
+};
+
+static void writeEmployee(ActionEntry& entry, const Employee& emp) {
+    entry.putInt(emp.getId());
+    entry.putString(emp.getName());
+    entry.putString(emp.getDepartment());
+    entry.putDouble(emp.getSalary());
+    entry.putString(emp.getPosition());
+    entry.putString(emp.getPassword());
+}
+
+static Employee readEmployee(ActionEntry& entry) {
+    Employee emp;
+    emp.setId(entry.getInt());
+    emp.setName(entry.getString());
+    emp.setDepartment(entry.getString());
+    emp.setSalary(entry.getDouble());
+    emp.setPosition(entry.getString());
+    emp.setPassword(entry.getString());
+    return emp;
+}
+
+static void writeEmployeeEdit(ActionEntry& entry, const Employee& before, const Employee& after) {
+    quint8 changed = 0;
+    if (before.getName() != after.getName()) changed |= FieldName;
+    if (before.getDepartment() != after.getDepartment()) changed |= FieldDepartment;
+    if (before.getSalary() != after.getSalary()) changed |= FieldSalary;
+    if (before.getPosition() != after.getPosition()) changed |= FieldPosition;
+    if (before.getPassword() != after.getPassword()) changed |= FieldPassword;
+    
+    entry.putInt(before.getId());
+    entry.putInt(after.getId());
+    entry.putByte(changed);
+    if (changed & FieldName) {
+        entry.putString(before.getName());
+        entry.putString(after.getName());
+    }
+    if (changed & FieldDepartment) {
+        entry.putString(before.getDepartment());
+        entry.putString(after.getDepartment());
+    }
+    if (changed & FieldSalary) {
+        entry.putDouble(before.getSalary());
+        entry.putDouble(after.getSalary());
+    }
+    if (changed & FieldPosition) {
+        entry.putString(before.getPosition());
+        entry.putString(after.getPosition());
+    }
+    if (changed & FieldPassword) {
+        entry.putString(before.getPassword());
+        entry.putString(after.getPassword());
+    }
+}
+
+// Apply the old (undo) or new (redo) side of the changed fields to emp
+static void applyEmployeeEdit(ActionEntry& entry, quint8 changed, bool useBefore, Employee& emp) {
+    if (changed & FieldName) {
+        QString before = entry.getString();
+        QString after = entry.getString();
+        emp.setName(useBefore ? before : after);
+    }
+    if (changed & FieldDepartment) {
+        QString before = entry.getString();
+        QString after = entry.getString();
+        emp.setDepartment(useBefore ? before : after);
+    }
+    if (changed & FieldSalary) {
+        double before = entry.getDouble();
+        double after = entry.getDouble();
+        emp.setSalary(useBefore ? before : after);
+    }
+    if (changed & FieldPosition) {
+        QString before = entry.getString();
+        QString after = entry.getString();
+        emp.setPosition(useBefore ? before : after);
+    }
+    if (changed & FieldPassword) {
+        QString before = entry.getString();
+        QString after = entry.getString();
+        emp.setPassword(useBefore ? before : after);
+    }
+}
+
+// ============================================================================
+// WRITE-AHEAD LOG ENCODING
+// ============================================================================
+// Log entries use the same ActionEntry encoding, starting with a LogType
+// byte. Replay calls the same mutators in the same order, starting from the
+// base file's checkpoint sequence, so each change is applied exactly once.
+
+enum class LogType : quint8 {
+    PutEmployee = 1,        // Whole employee
+    UpdateEmployee,         // ID before the edit, then the whole employee
+    DeleteEmployee,         // ID
+    SubmitLeave,            // Whole request
+    SetLeaveStatus,         // Employee ID, position in their bucket, status
+    PutAttendance,          // Entry and employee name
+    RemoveAttendance,       // Employee ID, day
+    PurgeAttendance,        // First and last day
+    ImportAttendance        // Count, then that many PutAttendance bodies
+};
+
+static quint32 logTypeBit(LogType type) {
+    return 1u << static_cast<quint8>(type);
+}
+
+// Which entries each loader replays
+static const quint32 EmployeeLogTypes = logTypeBit(LogType::PutEmployee) |
+                                        logTypeBit(LogType::UpdateEmployee) |
+                                        logTypeBit(LogType::DeleteEmployee);
+static const quint32 LeaveLogTypes = logTypeBit(LogType::SubmitLeave) |
+                                     logTypeBit(LogType::SetLeaveStatus);
+static const quint32 AttendanceLogTypes = logTypeBit(LogType::PutAttendance) |
+                                          logTypeBit(LogType::RemoveAttendance) |
+                                          logTypeBit(LogType::PurgeAttendance) |
+                                          logTypeBit(LogType::ImportAttendance);
+
+static ActionEntry logEntry(LogType type) {
+    ActionEntry entry;
+    entry.putByte(static_cast<quint8>(type));
+    return entry;
+}
+
+static void writeLeaveRequest(ActionEntry& entry, const LeaveRequest& request) {
+    entry.putInt(request.getEmployeeId());
+    entry.putString(request.getEmployeeName());
+    entry.putInt(static_cast<qint32>(request.getStartDate().toJulianDay()));
+    entry.putInt(static_cast<qint32>(request.getEndDate().toJulianDay()));
+    entry.putString(request.getReason());
+    entry.putByte(static_cast<quint8>(request.getStatus()));
+}
+
+static LeaveRequest readLeaveRequest(ActionEntry& entry) {
+    int employeeId = entry.getInt();
+    QString name = entry.getString();
+    QDate startDate = QDate::fromJulianDay(entry.getInt());
+    QDate endDate = QDate::fromJulianDay(entry.getInt());
+    QString reason = entry.getString();
+    LeaveRequest request(employeeId, name, startDate, endDate, reason);
+    request.setStatus(static_cast<LeaveStatus>(entry.getByte()));
+    return request;
+}
+
+// 16 bytes plus the name: both times share one int
+static void writeAttendance(ActionEntry& entry, const AttendanceEntry& record, const QString& name) {
+    entry.putInt(record.employeeId);
+    entry.putInt(record.day);
+    entry.putInt(static_cast<qint32>(record.timeIn | (static_cast<quint32>(record.timeOut) << 16)));
+    entry.putString(name);
+}
+
+static AttendanceRecord readAttendance(ActionEntry& entry) {
+    AttendanceEntry record;
+    record.employeeId = entry.getInt();
+    record.day = entry.getInt();
+    quint32 times = static_cast<quint32>(entry.getInt());
+    record.timeIn = static_cast<quint16>(times);
+    record.timeOut = static_cast<quint16>(times >> 16);
+    QString name = entry.getString();
+    return AttendanceRecord(record.employeeId, name, record.getDate(), record.getTimeIn(), record.getTimeOut());
+}
+
 // ============================================================================
-// EMPLOYEE OPERATIONS (Doubly Linked List + BST)
+// EMPLOYEE OPERATIONS (Doubly Linked List + AVL Tree)
 // ============================================================================
 
 void DataManager::addEmployee(const Employee& emp, bool recordAction) {
-    // Add to doubly linked list (maintains insertion order)
-    m_employeeList.insertAtEnd(emp);
+    // Add to doubly linked list (maintains insertion order); the first node
+    // with a given ID is the one edits and deletes go to
+    EmployeeNode* node = m_employeeList.insertAtEnd(emp);
+    if (!m_employeeNodes.contains(emp.getId())) {
+        m_employeeNodes.insert(emp.getId(), node);
+    }
     
-    // Add to BST (for fast search by ID)
-    m_employeeBST->insert(emp);
+    // Add to AVL tree (for fast search by ID)
+    m_employeeAVL->insert(emp);
     
     // Record action for undo
     if (recordAction) {
-        ActionRecord action;
-        action.type = ActionType::ADD_EMPLOYEE;
-        action.employee = emp;
-        m_undoStack.push(action);
-        m_redoStack.clear(); // Clear redo stack on new action
+        ActionEntry entry;
+        entry.putByte(static_cast<quint8>(ActionType::ADD_EMPLOYEE));
+        writeEmployee(entry, emp);
+        pushUndoEntry(entry);
     }
+    
+    ActionEntry change = logEntry(LogType::PutEmployee);
+    writeEmployee(change, emp);
+    logChange(change);
 }
 
 bool DataManager::updateEmployee(int id, const Employee& emp, bool recordAction) {
@@ -33,24 +225,40 @@ bool DataManager::updateEmployee(int id, const Employee& emp, bool recordAction)
     Employee* oldEmp = findEmployee(id);
     if (!oldEmp) return false;
     
+    // A new ID must not belong to another employee
+    if (emp.getId() != id && findEmployee(emp.getId())) return false;
+    
     Employee previousEmp = *oldEmp;
     
-    // Update in doubly linked list
-    m_employeeList.update([id](const Employee& e) { return e.getId() == id; }, emp);
+    // Update in doubly linked list through the node handle: O(1)
+    EmployeeNode* node = nullptr;
+    if (EmployeeNode** handle = m_employeeNodes.find(id)) {
+        node = *handle;
+        node->data = emp;
+    }
     
-    // Update in BST
-    m_employeeBST->update(id, emp);
+    // Update in AVL tree; an ID change moves the employee to its new key
+    if (emp.getId() != id) {
+        m_employeeAVL->remove(id);
+        m_employeeAVL->insert(emp);
+        m_employeeNodes.remove(id);
+        if (node) m_employeeNodes.insert(emp.getId(), node);
+    } else {
+        m_employeeAVL->update(id, emp);
+    }
     
     // Record action for undo
     if (recordAction) {
-        ActionRecord action;
-        action.type = ActionType::EDIT_EMPLOYEE;
-        action.employee = emp;
-        action.previousEmployee = previousEmp;
-        m_undoStack.push(action);
-        m_redoStack.clear();
+        ActionEntry entry;
+        entry.putByte(static_cast<quint8>(ActionType::EDIT_EMPLOYEE));
+        writeEmployeeEdit(entry, previousEmp, emp);
+        pushUndoEntry(entry);
     }
     
+    ActionEntry change = logEntry(LogType::UpdateEmployee);
+    change.putInt(id);
+    writeEmployee(change, emp);
+    logChange(change);
     return true;
 }
 
@@ -61,29 +269,32 @@ bool DataManager::deleteEmployee(int id, bool recordAction) {
     
     Employee deletedEmp = *emp;
     
-    // Delete from doubly linked list
-    m_employeeList.deleteByValue(deletedEmp, [](const Employee& a, const Employee& b) {
-        return a.getId() == b.getId();
-    });
+    // Unlink from doubly linked list through the node handle: O(1)
+    if (EmployeeNode** node = m_employeeNodes.find(id)) {
+        m_employeeList.unlink(*node);
+        m_employeeNodes.remove(id);
+    }
     
-    // Delete from BST
-    m_employeeBST->remove(id);
+    // Delete from AVL tree
+    m_employeeAVL->remove(id);
     
     // Record action for undo
     if (recordAction) {
-        ActionRecord action;
-        action.type = ActionType::DELETE_EMPLOYEE;
-        action.employee = deletedEmp;
-        m_undoStack.push(action);
-        m_redoStack.clear();
+        ActionEntry entry;
+        entry.putByte(static_cast<quint8>(ActionType::DELETE_EMPLOYEE));
+        writeEmployee(entry, deletedEmp);
+        pushUndoEntry(entry);
     }
     
+    ActionEntry change = logEntry(LogType::DeleteEmployee);
+    change.putInt(id);
+    logChange(change);
     return true;
 }
 
 Employee* DataManager::findEmployee(int id) {
-    // Use BST for O(log n) search
-    return m_employeeBST->search(id);
+    // Use AVL tree for guaranteed O(log n) search
+    return m_employeeAVL->search(id);
 }
 
 QList<Employee> DataManager::getAllEmployees() {
@@ -95,71 +306,100 @@ int DataManager::getEmployeeCount() {
     return m_employeeList.size();
 }
 
+RangeView<DoublyLinkedList<Employee>> DataManager::employeesView() const {
+    return RangeView<DoublyLinkedList<Employee>>(m_employeeList);
+}
+
+RangeView<AVLTree<Employee, int>> DataManager::employeesByIdView() const {
+    return RangeView<AVLTree<Employee, int>>(*m_employeeAVL);
+}
+
 
 // ============================================================================
-// LEAVE REQUEST OPERATIONS (Queue + Doubly Linked List)
+// LEAVE REQUEST OPERATIONS (Indexed Heap + Doubly Linked List + Hash Map)
 // ============================================================================
 
 void DataManager::submitLeaveRequest(const LeaveRequest& request) {
-    // Add to pending queue (FIFO processing)
-    if (request.getStatus() == LeaveStatus::Pending) {
-        m_pendingLeaveQueue.enqueue(request);
+    // Add to all leave requests list and the employee's bucket
+    LeaveNode* node = m_allLeaveRequests.insertAtEnd(request);
+    m_employeeLeaveRequests[request.getEmployeeId()].push_back(node);
+    
+    // Index by (employee, start date). An earlier request with the same key
+    // keeps the entry unless it was rejected, so a resubmission can be
+    // processed. Only an indexed request joins the pending heap (FIFO unless
+    // reordered): a duplicate from an old file could never be processed or
+    // popped, and would hide the rest of the queue once it reached the top.
+    quint64 key = LeaveKey::make(request);
+    LeaveHandle* existing = m_leaveIndex.find(key);
+    if (!existing || existing->node->data.getStatus() == LeaveStatus::Rejected) {
+        IndexedHeap<LeaveRequest>::Handle pending = -1;
+        if (request.getStatus() == LeaveStatus::Pending) {
+            pending = m_pendingLeaveHeap.push(request);
+        }
+        m_leaveIndex.insert(key, LeaveHandle{node, pending});
+        indexLeaveIntervals(node);
     }
     
-    // Add to all leave requests list
-    m_allLeaveRequests.insertAtEnd(request);
+    ActionEntry change = logEntry(LogType::SubmitLeave);
+    writeLeaveRequest(change, request);
+    logChange(change);
 }
 
 LeaveRequest* DataManager::getNextPendingRequest() {
-    LeaveRequest request;
-    if (m_pendingLeaveQueue.peek(request)) {
-        // Find in the main list and return pointer
-        return m_allLeaveRequests.find([&request](const LeaveRequest& r) {
-            return r.getEmployeeId() == request.getEmployeeId() &&
-                   r.getStartDate() == request.getStartDate() &&
-                   r.getStatus() == LeaveStatus::Pending;
-        });
+    const LeaveRequest* top = m_pendingLeaveHeap.top();
+    if (!top) return nullptr;
+    
+    // Hash lookup of the top request in the main list
+    LeaveHandle* handle = m_leaveIndex.find(LeaveKey::make(*top));
+    if (handle && handle->node->data.getStatus() == LeaveStatus::Pending) {
+        return &(handle->node->data);
     }
     return nullptr;
 }
 
 bool DataManager::processLeaveRequest(int employeeId, const QDate& startDate, 
                                        LeaveStatus newStatus, bool recordAction) {
-    // Find the request in all leave requests
-    LeaveRequest* request = m_allLeaveRequests.find([employeeId, &startDate](const LeaveRequest& r) {
-        return r.getEmployeeId() == employeeId && r.getStartDate() == startDate;
-    });
-    
-    if (!request) return false;
+    // Hash lookup by (employee, start date): O(1) regardless of request history
+    LeaveHandle* handle = m_leaveIndex.find(LeaveKey::make(employeeId, startDate));
+    if (!handle) return false;
     
-    LeaveStatus previousStatus = request->getStatus();
+    LeaveRequest& request = handle->node->data;
+    LeaveStatus previousStatus = request.getStatus();
     
-    // Update the status
-    LeaveRequest updatedRequest = *request;
-    updatedRequest.setStatus(newStatus);
+    // Update the status in place
+    request.setStatus(newStatus);
+    LeaveRequest updatedRequest = request;
     
-    m_allLeaveRequests.update([employeeId, &startDate](const LeaveRequest& r) {
-        return r.getEmployeeId() == employeeId && r.getStartDate() == startDate;
-    }, updatedRequest);
-    
-    // Remove from pending queue if was pending
-    if (previousStatus == LeaveStatus::Pending) {
-        m_pendingLeaveQueue.removeByCondition([employeeId, &startDate](const LeaveRequest& r) {
-            return r.getEmployeeId() == employeeId && r.getStartDate() == startDate;
-        });
+    // Keep the pending heap in step with the status: O(log n) by handle
+    if (handle->pending >= 0 && newStatus != LeaveStatus::Pending) {
+        m_pendingLeaveHeap.remove(handle->pending);
+        handle->pending = -1;
+    } else if (handle->pending < 0 && newStatus == LeaveStatus::Pending) {
+        // Undo of an approval/rejection puts the request back in the queue
+        handle->pending = m_pendingLeaveHeap.push(updatedRequest);
     }
+    indexLeaveIntervals(handle->node);
     
     // Record action for undo
     if (recordAction) {
-        ActionRecord action;
-        action.type = (newStatus == LeaveStatus::Approved) ? 
-                      ActionType::APPROVE_LEAVE : ActionType::REJECT_LEAVE;
-        action.leaveRequest = updatedRequest;
-        action.previousStatus = previousStatus;
-        m_undoStack.push(action);
-        m_redoStack.clear();
+        ActionType type = (newStatus == LeaveStatus::Approved) ? 
+                          ActionType::APPROVE_LEAVE : ActionType::REJECT_LEAVE;
+        ActionEntry entry;
+        entry.putByte(static_cast<quint8>(type));
+        entry.putInt(employeeId);
+        entry.putInt64(startDate.toJulianDay());
+        entry.putByte(static_cast<quint8>(previousStatus));
+        pushUndoEntry(entry);
     }
     
+    // Logged by bucket position: a reloaded index may point at another
+    // request with the same key
+    const std::vector<LeaveNode*>& bucket = m_employeeLeaveRequests[employeeId];
+    ActionEntry change = logEntry(LogType::SetLeaveStatus);
+    change.putInt(employeeId);
+    change.putInt(static_cast<qint32>(std::find(bucket.begin(), bucket.end(), handle->node) - bucket.begin()));
+    change.putByte(static_cast<quint8>(newStatus));
+    logChange(change);
     return true;
 }
 
@@ -168,140 +408,584 @@ QList<LeaveRequest> DataManager::getAllLeaveRequests() {
 }
 
 QList<LeaveRequest> DataManager::getPendingRequests() {
-    return m_pendingLeaveQueue.toQList();
+    // All pending requests in queue order
+    return m_pendingLeaveHeap.toQList();
 }
 
 QList<LeaveRequest> DataManager::getEmployeeLeaveRequests(int employeeId) {
     QList<LeaveRequest> result;
-    m_allLeaveRequests.traverseForward([&result, employeeId](const LeaveRequest& r) {
-        if (r.getEmployeeId() == employeeId) {
-            result.append(r);
+    
+    // Per-employee bucket: O(k) in this employee's requests
+    if (const std::vector<LeaveNode*>* bucket = m_employeeLeaveRequests.find(employeeId)) {
+        result.reserve(static_cast<int>(bucket->size()));
+        for (LeaveNode* node : *bucket) {
+            result.append(node->data);
         }
+    }
+    return result;
+}
+
+RangeView<DoublyLinkedList<LeaveRequest>> DataManager::leaveRequestsView() const {
+    return RangeView<DoublyLinkedList<LeaveRequest>>(m_allLeaveRequests);
+}
+
+void DataManager::setPendingLeaveOrder(PendingLeaveOrder order) {
+    switch (order) {
+        case PendingLeaveOrder::Submission:
+            m_pendingLeaveHeap.setKeyFunction(IndexedHeap<LeaveRequest>::KeyFunction());
+            break;
+            
+        case PendingLeaveOrder::StartDate:
+            m_pendingLeaveHeap.setKeyFunction([](const LeaveRequest& r) {
+                return r.getStartDate().toJulianDay();
+            });
+            break;
+            
+        case PendingLeaveOrder::Custom:
+            // Keep the current key; use setPendingLeaveKey() to supply one
+            break;
+    }
+    m_pendingLeaveOrder = order;
+}
+
+void DataManager::setPendingLeaveKey(IndexedHeap<LeaveRequest>::KeyFunction key) {
+    m_pendingLeaveHeap.setKeyFunction(key);
+    m_pendingLeaveOrder = PendingLeaveOrder::Custom;
+}
+
+PendingLeaveOrder DataManager::getPendingLeaveOrder() {
+    return m_pendingLeaveOrder;
+}
+
+QList<LeaveRequest> DataManager::getTopPendingRequests(int count) {
+    QList<LeaveRequest> result;
+    m_pendingLeaveHeap.visitTop(count, [&result](const LeaveRequest& r) {
+        result.append(r);
+    });
+    return result;
+}
+
+int DataManager::getPendingCount() {
+    return m_pendingLeaveHeap.size();
+}
+
+void DataManager::indexLeaveIntervals(LeaveNode* node) {
+    const LeaveRequest& request = node->data;
+    int employeeId = request.getEmployeeId();
+    qint64 start = request.getStartDate().toJulianDay();
+    qint64 end = std::max(start, request.getEndDate().toJulianDay());
+    quint64 id = LeaveKey::make(request);
+    
+    m_approvedLeaveTree.remove(start, id);
+    m_activeLeaveTree.remove(LeaveKey::make(employeeId, request.getStartDate()), id);
+    
+    LeaveStatus status = request.getStatus();
+    if (status == LeaveStatus::Approved) {
+        m_approvedLeaveTree.insert(start, end, id, node);
+    }
+    if (status == LeaveStatus::Pending || status == LeaveStatus::Approved) {
+        // Employee ID in the high bits keeps each employee's intervals apart
+        m_activeLeaveTree.insert(LeaveKey::make(employeeId, request.getStartDate()),
+                                 LeaveKey::make(employeeId, QDate::fromJulianDay(end)), id, node);
+    }
+}
+
+QList<LeaveRequest> DataManager::getApprovedLeavesOn(const QDate& date) {
+    QList<LeaveRequest> result;
+    m_approvedLeaveTree.stab(date.toJulianDay(), [&result](LeaveNode* node) {
+        result.append(node->data);
+    });
+    return result;
+}
+
+QList<LeaveRequest> DataManager::getOverlappingLeaveRequests(int employeeId, const QDate& start,
+                                                             const QDate& end) {
+    QList<LeaveRequest> result;
+    m_activeLeaveTree.overlapping(LeaveKey::make(employeeId, start), LeaveKey::make(employeeId, end),
+                                  [&result](LeaveNode* node) {
+        result.append(node->data);
     });
     return result;
 }
 
+bool DataManager::hasOverlappingLeave(int employeeId, const QDate& start, const QDate& end) {
+    return m_activeLeaveTree.overlapsAny(LeaveKey::make(employeeId, start), LeaveKey::make(employeeId, end));
+}
+
 
 // ============================================================================
-// ATTENDANCE OPERATIONS (AVL Tree)
+// ATTENDANCE OPERATIONS (B+ Tree + AVL Tree)
 // ============================================================================
 
 void DataManager::addAttendanceRecord(const AttendanceRecord& record) {
-    m_attendanceAVL->insert(record);
+    AttendanceEntry entry = record.toEntry();
+    m_attendanceBPlusTree->insert(entry);
+    
+    // Keep per-employee index in sync; back-dated records go to the history
+    if (entry.day < m_attendanceArchiveDay) {
+        m_attendanceHistory[entry.employeeId].insert(entry);
+    } else {
+        m_employeeAttendanceAVL->insert(entry);
+    }
+    m_attendanceNames.insert(record.getEmployeeId(), record.getEmployeeNameId());
+    m_presence[entry.employeeId].set(entry.day);
+    
+    ActionEntry change = logEntry(LogType::PutAttendance);
+    writeAttendance(change, entry, record.getEmployeeName());
+    logChange(change);
+    
+    // Today's records arrive in key order; back-dated ones force a rebuild
+    if (!m_attendanceColumnsStale && !m_attendanceColumns.append(entry)) {
+        m_attendanceColumnsStale = true;
+    }
+}
+
+bool DataManager::removeAttendanceRecord(int employeeId, const QDate& date) {
+    if (!m_attendanceBPlusTree->remove(AttendanceKey::make(date, employeeId))) {
+        return false;
+    }
+    
+    qint32 day = static_cast<qint32>(date.toJulianDay());
+    if (day < m_attendanceArchiveDay) {
+        AttendancePostings* history = m_attendanceHistory.find(employeeId);
+        if (history) {
+            history->remove(day);
+        }
+    } else {
+        m_employeeAttendanceAVL->remove(AttendanceKey::byEmployee(employeeId, day));
+    }
+    m_attendanceColumnsStale = true;
+    
+    ActionEntry change = logEntry(LogType::RemoveAttendance);
+    change.putInt(employeeId);
+    change.putInt(day);
+    logChange(change);
+    
+    PresenceBitmap* presence = m_presence.find(employeeId);
+    if (presence) {
+        presence->reset(day);
+    }
+    return true;
 }
 
-AttendanceRecord* DataManager::findAttendanceRecord(int employeeId, const QDate& date) {
-    QString key = date.toString("yyyy-MM-dd") + "_" + QString::number(employeeId);
-    return m_attendanceAVL->search(key);
+bool DataManager::findAttendanceRecord(int employeeId, const QDate& date, AttendanceRecord& record) {
+    AttendanceEntry* entry = m_attendanceBPlusTree->search(AttendanceKey::make(date, employeeId));
+    if (!entry) {
+        return false;
+    }
+    record = toAttendanceRecord(*entry);
+    return true;
 }
 
 QList<AttendanceRecord> DataManager::getAttendanceByDateRange(const QDate& start, const QDate& end) {
     QList<AttendanceRecord> result;
     
-    // Use AVL range search for efficient date range queries
-    QString lowKey = start.toString("yyyy-MM-dd") + "_0";
-    QString highKey = end.toString("yyyy-MM-dd") + "_999999";
+    // Use B+ tree range search: one descent, then a sequential leaf scan
+    // Integer bounds cover every employee ID on the first and last day
+    quint64 lowKey = AttendanceKey::lowerBound(start);
+    quint64 highKey = AttendanceKey::upperBound(end);
     
-    m_attendanceAVL->rangeSearch(lowKey, highKey, [&result](const AttendanceRecord& r) {
-        result.append(r);
+    m_attendanceBPlusTree->rangeSearch(lowKey, highKey, [this, &result](const AttendanceEntry& e) {
+        result.append(toAttendanceRecord(e));
     });
     
     return result;
 }
 
+template<typename Visitor>
+void DataManager::visitEmployeeAttendance(int employeeId, qint32 firstDay, qint32 lastDay,
+                                          Visitor&& visitor) const {
+    if (firstDay < m_attendanceArchiveDay) {
+        const AttendancePostings* history = m_attendanceHistory.find(employeeId);
+        if (history) {
+            history->rangeSearch(firstDay, qMin(lastDay, m_attendanceArchiveDay - 1), visitor);
+        }
+    }
+    if (lastDay >= m_attendanceArchiveDay) {
+        // Per-employee index keeps one employee's records contiguous: O(log n + k)
+        m_employeeAttendanceAVL->rangeSearch(AttendanceKey::byEmployee(employeeId, qMax(firstDay, m_attendanceArchiveDay)),
+                                             AttendanceKey::byEmployee(employeeId, lastDay), visitor);
+    }
+}
+
 QList<AttendanceRecord> DataManager::getEmployeeAttendance(int employeeId) {
-    return m_attendanceAVL->findAll([employeeId](const AttendanceRecord& r) {
-        return r.getEmployeeId() == employeeId;
+    QList<AttendanceRecord> result;
+    visitEmployeeAttendance(employeeId, 0, std::numeric_limits<qint32>::max(),
+                            [this, &result](const AttendanceEntry& e) {
+        result.append(toAttendanceRecord(e));
+    });
+    return result;
+}
+
+QList<AttendanceRecord> DataManager::getEmployeeAttendanceByDateRange(int employeeId, const QDate& start,
+                                                                     const QDate& end) {
+    QList<AttendanceRecord> result;
+    visitEmployeeAttendance(employeeId, static_cast<qint32>(start.toJulianDay()),
+                            static_cast<qint32>(end.toJulianDay()),
+                            [this, &result](const AttendanceEntry& e) {
+        result.append(toAttendanceRecord(e));
     });
+    return result;
+}
+
+void DataManager::getPresenceCounts(int employeeId, const QDate& start, const QDate& end,
+                                    int& present, int& absent) const {
+    // Popcounts over the employee's bitmap: one 64-bit word per 64 days
+    qint32 firstDay = static_cast<qint32>(start.toJulianDay());
+    qint32 lastDay = static_cast<qint32>(end.toJulianDay());
+    const PresenceBitmap* presence = m_presence.find(employeeId);
+    if (presence) {
+        present = presence->count(firstDay, lastDay);
+        absent = presence->countAbsent(firstDay, lastDay);
+    } else {
+        present = 0;
+        absent = PresenceBitmap::countWorkingDays(firstDay, lastDay);
+    }
+}
+
+int DataManager::countEmployeeAttendance(int employeeId, const QDate& start, const QDate& end) const {
+    qint32 firstDay = static_cast<qint32>(start.toJulianDay());
+    qint32 lastDay = static_cast<qint32>(end.toJulianDay());
+    int count = 0;
+    
+    // History blocks inside the range are counted from their headers
+    if (firstDay < m_attendanceArchiveDay) {
+        const AttendancePostings* history = m_attendanceHistory.find(employeeId);
+        if (history) {
+            count += history->countInRange(firstDay, qMin(lastDay, m_attendanceArchiveDay - 1));
+        }
+    }
+    
+    // Subtree sizes answer the count in O(log n) without copying any records
+    if (lastDay >= m_attendanceArchiveDay) {
+        count += m_employeeAttendanceAVL->countInRange(
+            AttendanceKey::byEmployee(employeeId, qMax(firstDay, m_attendanceArchiveDay)),
+            AttendanceKey::byEmployee(employeeId, lastDay));
+    }
+    return count;
+}
+
+bool DataManager::getLatestAttendance(int employeeId, AttendanceRecord& record) {
+    // Largest key within this employee's key range is the most recent day
+    AttendanceEntry* entry = m_employeeAttendanceAVL->findFloor(AttendanceKey::employeeUpperBound(employeeId));
+    if (entry && entry->employeeId == employeeId) {
+        record = toAttendanceRecord(*entry);
+        return true;
+    }
+    
+    // Nothing in the recent window: the last archived day
+    const AttendancePostings* history = m_attendanceHistory.find(employeeId);
+    AttendanceEntry last;
+    if (history && history->last(last)) {
+        record = toAttendanceRecord(last);
+        return true;
+    }
+    return false;
 }
 
 bool DataManager::hasAttendanceToday(int employeeId) {
     QDate today = QDate::currentDate();
-    return findAttendanceRecord(employeeId, today) != nullptr;
+    return m_attendanceBPlusTree->search(AttendanceKey::make(today, employeeId)) != nullptr;
+}
+
+RangeView<BPlusTree<AttendanceEntry, quint64>> DataManager::attendanceView() const {
+    return RangeView<BPlusTree<AttendanceEntry, quint64>>(*m_attendanceBPlusTree);
+}
+
+AttendanceRecord DataManager::toAttendanceRecord(const AttendanceEntry& entry) const {
+    const StringPool::Id* name = m_attendanceNames.find(entry.employeeId);
+    return AttendanceRecord::fromEntry(entry, name ? *name : 0);
+}
+
+void DataManager::refreshAttendanceColumns() {
+    if (!m_attendanceColumnsStale) {
+        return;
+    }
+    
+    // The B+ tree leaf chain is already in key order
+    m_attendanceColumns.clear();
+    m_attendanceColumns.reserve(m_attendanceBPlusTree->size());
+    m_attendanceBPlusTree->inorderTraversal([this](const AttendanceEntry& entry) {
+        m_attendanceColumns.append(entry);
+    });
+    m_attendanceColumnsStale = false;
+}
+
+AttendanceSummary DataManager::summarizeAttendance(const QDate& start, const QDate& end) {
+    refreshAttendanceColumns();
+    return m_attendanceColumns.summarize(static_cast<qint32>(start.toJulianDay()),
+                                         static_cast<qint32>(end.toJulianDay()));
+}
+
+QList<AttendanceSummary> DataManager::summarizeAttendanceByEmployee(const QDate& start, const QDate& end) {
+    refreshAttendanceColumns();
+    std::vector<AttendanceSummary> summaries =
+        m_attendanceColumns.summarizeByEmployee(static_cast<qint32>(start.toJulianDay()),
+                                                static_cast<qint32>(end.toJulianDay()));
+    
+    QList<AttendanceSummary> result;
+    result.reserve(static_cast<int>(summaries.size()));
+    for (const AttendanceSummary& summary : summaries) {
+        result.append(summary);
+    }
+    return result;
+}
+
+AttendanceSummary DataManager::summarizeEmployeeAttendance(int employeeId, const QDate& start,
+                                                           const QDate& end) {
+    // One employee's records are a contiguous key range in the per-employee
+    // index; walking those k nodes beats filtering the company-wide columns
+    AttendanceSummary summary;
+    summary.employeeId = employeeId;
+    visitEmployeeAttendance(employeeId, static_cast<qint32>(start.toJulianDay()),
+                            static_cast<qint32>(end.toJulianDay()),
+                            [&summary](const AttendanceEntry& e) {
+        summary.add(e.timeIn, e.timeOut);
+    });
+    return summary;
+}
+
+void DataManager::archiveAttendanceBefore(const QDate& day) {
+    qint32 archiveDay = static_cast<qint32>(day.toJulianDay());
+    if (archiveDay <= m_attendanceArchiveDay) {
+        return;
+    }
+    
+    // Each employee's archived days are one key range in the AVL index: move
+    // it to the history (every archived day is later than the existing
+    // history, so each move is an append), then cut it out with one eraseRange
+    std::vector<int> employeeIds;
+    employeeIds.reserve(m_attendanceNames.size());
+    m_attendanceNames.forEach([&employeeIds](int employeeId, StringPool::Id) {
+        employeeIds.push_back(employeeId);
+    });
+    for (int employeeId : employeeIds) {
+        quint64 low = AttendanceKey::byEmployee(employeeId, m_attendanceArchiveDay);
+        quint64 high = AttendanceKey::byEmployee(employeeId, archiveDay - 1);
+        if (m_employeeAttendanceAVL->countInRange(low, high) == 0) continue;
+        
+        AttendancePostings& history = m_attendanceHistory[employeeId];
+        m_employeeAttendanceAVL->rangeSearch(low, high, [&history](const AttendanceEntry& e) {
+            history.append(e);
+        });
+        m_employeeAttendanceAVL->eraseRange(low, high);
+    }
+    m_attendanceArchiveDay = archiveDay;
+}
+
+int DataManager::purgeAttendance(const QDate& start, const QDate& end) {
+    if (end < start) {
+        return 0;
+    }
+    qint32 firstDay = static_cast<qint32>(start.toJulianDay());
+    qint32 lastDay = static_cast<qint32>(end.toJulianDay());
+    
+    // The date range is one leaf run in the B+ tree: read it for the other
+    // stores, then unlink its pages in one eraseRange
+    quint64 low = AttendanceKey::lowerBound(start);
+    quint64 high = AttendanceKey::upperBound(end);
+    std::vector<AttendanceEntry> purged;
+    m_attendanceBPlusTree->rangeSearch(low, high, [&purged](const AttendanceEntry& e) {
+        purged.push_back(e);
+    });
+    if (purged.empty()) {
+        return 0;
+    }
+    m_attendanceBPlusTree->eraseRange(low, high);
+    
+    std::vector<int> employeeIds;
+    for (const AttendanceEntry& e : purged) {
+        if (PresenceBitmap* presence = m_presence.find(e.employeeId)) {
+            presence->reset(e.day);
+        }
+        employeeIds.push_back(e.employeeId);
+    }
+    std::sort(employeeIds.begin(), employeeIds.end());
+    employeeIds.erase(std::unique(employeeIds.begin(), employeeIds.end()), employeeIds.end());
+    
+    // The per-employee stores hold the range as one key range per employee
+    qint32 recentFirst = std::max(firstDay, m_attendanceArchiveDay);
+    for (int employeeId : employeeIds) {
+        if (lastDay >= recentFirst) {
+            m_employeeAttendanceAVL->eraseRange(AttendanceKey::byEmployee(employeeId, recentFirst),
+                                                AttendanceKey::byEmployee(employeeId, lastDay));
+        }
+        if (firstDay < m_attendanceArchiveDay) {
+            if (AttendancePostings* history = m_attendanceHistory.find(employeeId)) {
+                history->eraseRange(firstDay, std::min(lastDay, m_attendanceArchiveDay - 1));
+            }
+        }
+    }
+    m_attendanceColumnsStale = true;
+    
+    ActionEntry change = logEntry(LogType::PurgeAttendance);
+    change.putInt(firstDay);
+    change.putInt(lastDay);
+    logChange(change);
+    return static_cast<int>(purged.size());
+}
+
+void DataManager::importAttendanceRecords(const QList<AttendanceRecord>& records) {
+    // The whole batch is one log entry
+    ActionEntry change = logEntry(LogType::ImportAttendance);
+    change.putInt(records.size());
+    
+    std::vector<AttendanceEntry> entries;
+    std::vector<AttendanceEntry> recent;
+    entries.reserve(records.size());
+    recent.reserve(records.size());
+    for (const AttendanceRecord& record : records) {
+        AttendanceEntry entry = record.toEntry();
+        entries.push_back(entry);
+        if (entry.day < m_attendanceArchiveDay) {
+            m_attendanceHistory[entry.employeeId].insert(entry);
+        } else {
+            recent.push_back(entry);
+        }
+        m_attendanceNames.insert(entry.employeeId, record.getEmployeeNameId());
+        m_presence[entry.employeeId].set(entry.day);
+        writeAttendance(change, entry, record.getEmployeeName());
+    }
+    
+    // One union merges the batch into each index: O(m log(n/m + 1)) for the
+    // AVL tree, one pass over the leaf chain for the B+ tree
+    m_attendanceBPlusTree->unionWith(entries);
+    m_employeeAttendanceAVL->unionWith(recent);
+    if (!records.isEmpty()) {
+        m_attendanceColumnsStale = true;
+        logChange(change);
+    }
+}
+
+QDate DataManager::getAttendanceArchiveDate() const {
+    return QDate::fromJulianDay(m_attendanceArchiveDay);
+}
+
+int DataManager::getAttendanceHistoryMemory() const {
+    int bytes = 0;
+    m_attendanceHistory.forEach([&bytes](int, const AttendancePostings& history) {
+        bytes += history.memoryUsage();
+    });
+    return bytes;
 }
 
 
 // ============================================================================
-// UNDO/REDO OPERATIONS (Stack)
+// UNDO/REDO OPERATIONS (Action Log)
 // ============================================================================
 
+void DataManager::pushUndoEntry(const ActionEntry& entry) {
+    m_undoLog.push(entry);
+    m_redoLog.clear(); // A new action invalidates the redo history
+}
+
 bool DataManager::undo() {
-    ActionRecord action;
-    if (!m_undoStack.pop(action)) return false;
+    ActionEntry entry;
+    if (!m_undoLog.pop(entry)) return false;
     
-    switch (action.type) {
+    switch (static_cast<ActionType>(entry.getByte())) {
         case ActionType::ADD_EMPLOYEE:
             // Undo add = delete
-            deleteEmployee(action.employee.getId(), false);
+            deleteEmployee(readEmployee(entry).getId(), false);
             break;
             
-        case ActionType::EDIT_EMPLOYEE:
-            // Undo edit = restore previous
-            updateEmployee(action.employee.getId(), action.previousEmployee, false);
+        case ActionType::EDIT_EMPLOYEE: {
+            // Undo edit = put the changed fields and the old ID back
+            int beforeId = entry.getInt();
+            int afterId = entry.getInt();
+            quint8 changed = entry.getByte();
+            if (Employee* current = findEmployee(afterId)) {
+                Employee restored = *current;
+                restored.setId(beforeId);
+                applyEmployeeEdit(entry, changed, true, restored);
+                updateEmployee(afterId, restored, false);
+            }
             break;
+        }
             
         case ActionType::DELETE_EMPLOYEE:
             // Undo delete = add back
-            addEmployee(action.employee, false);
+            addEmployee(readEmployee(entry), false);
             break;
             
         case ActionType::APPROVE_LEAVE:
-        case ActionType::REJECT_LEAVE:
+        case ActionType::REJECT_LEAVE: {
             // Undo status change = restore previous status
-            processLeaveRequest(action.leaveRequest.getEmployeeId(),
-                               action.leaveRequest.getStartDate(),
-                               action.previousStatus, false);
+            int employeeId = entry.getInt();
+            QDate startDate = QDate::fromJulianDay(entry.getInt64());
+            LeaveStatus previousStatus = static_cast<LeaveStatus>(entry.getByte());
+            processLeaveRequest(employeeId, startDate, previousStatus, false);
             break;
+        }
     }
     
-    // Push to redo stack
-    m_redoStack.push(action);
+    // Same bytes go to the redo log
+    m_redoLog.push(entry);
     return true;
 }
 
 bool DataManager::redo() {
-    ActionRecord action;
-    if (!m_redoStack.pop(action)) return false;
+    ActionEntry entry;
+    if (!m_redoLog.pop(entry)) return false;
     
-    switch (action.type) {
+    ActionType type = static_cast<ActionType>(entry.getByte());
+    switch (type) {
         case ActionType::ADD_EMPLOYEE:
-            addEmployee(action.employee, false);
+            addEmployee(readEmployee(entry), false);
             break;
             
-        case ActionType::EDIT_EMPLOYEE:
-            updateEmployee(action.employee.getId(), action.employee, false);
+        case ActionType::EDIT_EMPLOYEE: {
+            int beforeId = entry.getInt();
+            int afterId = entry.getInt();
+            quint8 changed = entry.getByte();
+            if (Employee* current = findEmployee(beforeId)) {
+                Employee edited = *current;
+                edited.setId(afterId);
+                applyEmployeeEdit(entry, changed, false, edited);
+                updateEmployee(beforeId, edited, false);
+            }
             break;
+        }
             
         case ActionType::DELETE_EMPLOYEE:
-            deleteEmployee(action.employee.getId(), false);
+            deleteEmployee(readEmployee(entry).getId(), false);
             break;
             
         case ActionType::APPROVE_LEAVE:
-            processLeaveRequest(action.leaveRequest.getEmployeeId(),
-                               action.leaveRequest.getStartDate(),
-                               LeaveStatus::Approved, false);
-            break;
-            
-        case ActionType::REJECT_LEAVE:
-            processLeaveRequest(action.leaveRequest.getEmployeeId(),
-                               action.leaveRequest.getStartDate(),
-                               LeaveStatus::Rejected, false);
+        case ActionType::REJECT_LEAVE: {
+            int employeeId = entry.getInt();
+            QDate startDate = QDate::fromJulianDay(entry.getInt64());
+            LeaveStatus newStatus = (type == ActionType::APPROVE_LEAVE) ?
+                                    LeaveStatus::Approved : LeaveStatus::Rejected;
+            processLeaveRequest(employeeId, startDate, newStatus, false);
             break;
+        }
     }
     
-    // Push back to undo stack
-    m_undoStack.push(action);
+    // Push back to undo log
+    m_undoLog.push(entry);
     return true;
 }
 
 bool DataManager::canUndo() {
-    ActionRecord temp;
-    return m_undoStack.peek(temp);
+    return !m_undoLog.isEmpty();
 }
 
 bool DataManager::canRedo() {
-    ActionRecord temp;
-    return m_redoStack.peek(temp);
+    return !m_redoLog.isEmpty();
+}
+
+void DataManager::setUndoBudget(int bytes) {
+    m_undoLog.setBudget(bytes);
+    m_redoLog.setBudget(bytes);
+}
+
+int DataManager::getUndoBudget() const {
+    return m_undoLog.budget();
+}
+
+int DataManager::getUndoMemoryUsage() const {
+    return m_undoLog.bytesUsed() + m_redoLog.bytesUsed();
 }
 
 
@@ -309,123 +993,370 @@ bool DataManager::canRedo() {
 // FILE OPERATIONS
 // ============================================================================
 
+static const char* const EmployeeBaseFile = "employees.txt";
+static const char* const LeaveBaseFile = "leave_requests.txt";
+static const char* const AttendanceBaseFile = "attendance.dat";
+static const char* const AttendanceTextFile = "attendance.txt";
+static const char* const CheckpointLogFile = "changes_checkpoint.wal";
+
+
+// Base files are replaced through QSaveFile in one rename, so a failed or
+// interrupted write leaves the previous file intact. Each records the log
+// sequence number of the first change it does not contain; older files
+// without it replay the whole log.
+static bool writeEmployeeBase(const DoublyLinkedList<Employee>& employees, quint64 sequence) {
+    QSaveFile file(EmployeeBaseFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << AttendanceFile::checkpointLine(sequence) << "\n";
+    
+    // Traverse doubly linked list and save
+    employees.traverseForward([&out](const Employee& emp) {
+        out << emp.toFileString() << "\n";
+    });
+    
+    out.flush();
+    return file.commit();
+}
+
+static bool writeLeaveBase(const DoublyLinkedList<LeaveRequest>& requests, quint64 sequence) {
+    QSaveFile file(LeaveBaseFile);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << AttendanceFile::checkpointLine(sequence) << "\n";
+    
+    requests.traverseForward([&out](const LeaveRequest& request) {
+        out << request.toFileString() << "\n";
+    });
+    
+    out.flush();
+    return file.commit();
+}
+
+// Runs on the checkpoint thread, so it reads only its own snapshot. The
+// binary file supersedes a text base from an older version.
+static bool writeAttendanceBase(const AttendanceFile::Contents& contents) {
+    if (!AttendanceFile::writeBinary(AttendanceBaseFile, contents)) {
+        return false;
+    }
+    QFile::remove(AttendanceTextFile);
+    return true;
+}
+
 void DataManager::loadAllData() {
     loadEmployees();
     loadLeaveRequests();
     loadAttendanceRecords();
 }
 
-void DataManager::saveAllData() {
-    saveEmployees();
-    saveLeaveRequests();
-    saveAttendanceRecords();
+bool DataManager::saveAllData() {
+    // A change that reached neither the log nor the base files is retried
+    // by rewriting the base files
+    if (!m_saveError.isEmpty() && rewriteBaseFiles()) {
+        m_saveError.clear();
+    }
+    
+    // Every other change is already in the log; checkpoints only bound its length
+    if (m_saveError.isEmpty() && m_log.entryCount() >= CheckpointLogEntries && !m_checkpoint.isRunning()) {
+        checkpoint();
+    }
+    return m_saveError.isEmpty();
+}
+
+QString DataManager::getSaveError() const {
+    return m_saveError;
+}
+
+bool DataManager::hasEmployeeFiles() const {
+    return QFile::exists(EmployeeBaseFile) || QFile::exists(m_log.getFileName()) ||
+           QFile::exists(CheckpointLogFile);
 }
 
 void DataManager::loadEmployees() {
     // Clear existing data
     m_employeeList.clear();
-    m_employeeBST->clear();
+    m_employeeNodes.clear();
+    m_employeeAVL->clear();
+    m_loading = true;
+    quint64 sequence = 0;
     
-    QFile file("employees.txt");
+    QFile file(EmployeeBaseFile);
     
     if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         QTextStream in(&file);
+        std::vector<Employee> employees;
         while (!in.atEnd()) {
             QString line = in.readLine().trimmed();
-            if (!line.isEmpty()) {
+            if (!line.isEmpty() && !AttendanceFile::readCheckpointLine(line, sequence)) {
                 Employee emp = Employee::fromFileString(line);
                 if (emp.getId() > 0) {
-                    m_employeeList.insertAtEnd(emp);
-                    m_employeeBST->insert(emp);
+                    employees.push_back(emp);
                 }
             }
         }
         file.close();
+        
+        // List keeps file order; the ID tree is built in one pass instead of
+        // rebalancing after every insert
+        for (const Employee& emp : employees) {
+            EmployeeNode* node = m_employeeList.insertAtEnd(emp);
+            if (!m_employeeNodes.contains(emp.getId())) {
+                m_employeeNodes.insert(emp.getId(), node);
+            }
+        }
+        m_employeeAVL->bulkLoad(employees);
     }
+    
+    replayLog(EmployeeLogTypes, sequence);
+    m_loading = false;
 }
 
-void DataManager::saveEmployees() {
-    QFile file("employees.txt");
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
-        
-        // Traverse doubly linked list and save
-        m_employeeList.traverseForward([&out](const Employee& emp) {
-            out << emp.toFileString() << "\n";
-        });
-        
-        file.close();
-    }
+bool DataManager::saveEmployees() {
+    return saveAllData();
 }
 
 void DataManager::loadLeaveRequests() {
     // Clear existing data
     m_allLeaveRequests.clear();
-    m_pendingLeaveQueue.clear();
+    m_pendingLeaveHeap.clear();
+    m_leaveIndex.clear();
+    m_employeeLeaveRequests.clear();
+    m_approvedLeaveTree.clear();
+    m_activeLeaveTree.clear();
+    m_loading = true;
+    quint64 sequence = 0;
     
-    QFile file("leave_requests.txt");
+    QFile file(LeaveBaseFile);
     if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         QTextStream in(&file);
         while (!in.atEnd()) {
             QString line = in.readLine().trimmed();
-            if (!line.isEmpty()) {
+            if (!line.isEmpty() && !AttendanceFile::readCheckpointLine(line, sequence)) {
                 LeaveRequest request = LeaveRequest::fromFileString(line);
                 if (request.getEmployeeId() > 0) {
-                    m_allLeaveRequests.insertAtEnd(request);
-                    
-                    // Add pending requests to queue
-                    if (request.getStatus() == LeaveStatus::Pending) {
-                        m_pendingLeaveQueue.enqueue(request);
-                    }
+                    // Adds to the list, the pending queue and the hash index
+                    submitLeaveRequest(request);
                 }
             }
         }
         file.close();
     }
+    
+    replayLog(LeaveLogTypes, sequence);
+    m_loading = false;
+}
+
+bool DataManager::saveLeaveRequests() {
+    return saveAllData();
 }
 
-void DataManager::saveLeaveRequests() {
-    QFile file("leave_requests.txt");
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
+void DataManager::loadAttendanceRecords() {
+    // A running checkpoint may still be writing the base file
+    m_checkpoint.waitForFinished();
+    
+    m_attendanceBPlusTree->clear();
+    m_employeeAttendanceAVL->clear();
+    m_attendanceNames.clear();
+    m_attendanceColumns.clear();
+    m_attendanceColumnsStale = true;
+    m_presence.clear();
+    m_attendanceHistory.clear();
+    m_loading = true;
+    
+    // Only this month and the previous RecentAttendanceMonths stay in the AVL index
+    QDate today = QDate::currentDate();
+    QDate archiveDate = QDate(today.year(), today.month(), 1).addMonths(-RecentAttendanceMonths);
+    m_attendanceArchiveDay = static_cast<qint32>(archiveDate.toJulianDay());
+    
+    // The binary base is mapped and copied, not parsed; a text base is
+    // only read until the first checkpoint replaces it
+    AttendanceFile::Contents base;
+    if (AttendanceFile::readBinary(AttendanceBaseFile, base) ||
+        AttendanceFile::readText(AttendanceTextFile, base)) {
+        const std::vector<AttendanceEntry>& records = base.entries;
+        StringPool& pool = StringPool::getInstance();
+        for (QHash<int, QString>::const_iterator it = base.names.constBegin(); it != base.names.constEnd(); ++it) {
+            m_attendanceNames.insert(it.key(), pool.intern(it.value()));
+        }
+        for (const AttendanceEntry& entry : records) {
+            m_presence[entry.employeeId].set(entry.day);
+        }
         
-        m_allLeaveRequests.traverseForward([&out](const LeaveRequest& request) {
-            out << request.toFileString() << "\n";
-        });
+        // The file is saved in date order, so the B+ tree is packed in O(n)
+        m_attendanceBPlusTree->bulkLoad(records);
         
-        file.close();
+        // The B+ tree visits records by day, so each employee's days arrive in
+        // order without a sort: older ones are appended to the compressed
+        // history, the recent window is built without rotations
+        std::vector<AttendanceEntry> recent;
+        m_attendanceBPlusTree->inorderTraversal([this, &recent](const AttendanceEntry& entry) {
+            if (entry.day < m_attendanceArchiveDay) {
+                m_attendanceHistory[entry.employeeId].append(entry);
+            } else {
+                recent.push_back(entry);
+            }
+        });
+        m_employeeAttendanceAVL->bulkLoad(recent);
     }
+    
+    replayLog(AttendanceLogTypes, base.sequence);
+    m_loading = false;
 }
 
-void DataManager::loadAttendanceRecords() {
-    m_attendanceAVL->clear();
+bool DataManager::saveAttendanceRecords() {
+    return saveAllData();
+}
+
+void DataManager::checkpoint() {
+    m_checkpoint.waitForFinished();
     
-    QFile file("attendance.txt");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        while (!in.atEnd()) {
-            QString line = in.readLine().trimmed();
-            if (!line.isEmpty()) {
-                AttendanceRecord record = AttendanceRecord::fromFileString(line);
-                if (record.getEmployeeId() > 0) {
-                    m_attendanceAVL->insert(record);
-                }
-            }
+    // The base files written below cover every logged change, so they are
+    // stamped with the next sequence number. The retired log is kept until
+    // all of them are committed; on load each base skips the entries it has.
+    if (!m_log.moveTo(CheckpointLogFile)) {
+        return;
+    }
+    quint64 sequence = m_log.getNextSequence();
+    bool written = writeEmployeeBase(m_employeeList, sequence) &&
+                   writeLeaveBase(m_allLeaveRequests, sequence);
+    
+    // Attendance is the large one: snapshot it here and write it on a
+    // worker thread
+    std::shared_ptr<AttendanceFile::Contents> attendance = snapshotAttendance(sequence);
+    m_checkpoint = QtConcurrent::run([attendance, written]() {
+        if (writeAttendanceBase(*attendance) && written) {
+            QFile::remove(CheckpointLogFile);
         }
-        file.close();
+    });
+}
+
+bool DataManager::rewriteBaseFiles() {
+    m_checkpoint.waitForFinished();
+    quint64 sequence = m_log.getNextSequence();
+    return writeEmployeeBase(m_employeeList, sequence) &&
+           writeLeaveBase(m_allLeaveRequests, sequence) &&
+           writeAttendanceBase(*snapshotAttendance(sequence));
+}
+
+// Names are resolved here, as the string pool belongs to this thread
+std::shared_ptr<AttendanceFile::Contents> DataManager::snapshotAttendance(quint64 sequence) const {
+    std::shared_ptr<AttendanceFile::Contents> attendance = std::make_shared<AttendanceFile::Contents>();
+    attendance->entries.reserve(m_attendanceBPlusTree->size());
+    m_attendanceBPlusTree->inorderTraversal([&attendance](const AttendanceEntry& e) {
+        attendance->entries.push_back(e);
+    });
+    const StringPool& pool = StringPool::getInstance();
+    m_attendanceNames.forEach([&attendance, &pool](int employeeId, StringPool::Id name) {
+        attendance->names.insert(employeeId, pool.get(name));
+    });
+    attendance->sequence = sequence;
+    return attendance;
+}
+
+void DataManager::logChange(const ActionEntry& entry) {
+    if (m_loading) return;
+    
+    // After an unsaved change the log has a gap, so only a full rewrite
+    // brings the files back in line with memory
+    if (m_saveError.isEmpty()) {
+        if (m_log.append(entry.data(), static_cast<int>(entry.size()))) return;
+        qWarning() << "Cannot append to" << m_log.getFileName() << "- rewriting the data files instead";
     }
+    
+    if (rewriteBaseFiles()) {
+        m_saveError.clear();
+    } else {
+        m_saveError = QString("Changes could not be saved: neither %1 nor the data files in %2 can be written.")
+                          .arg(m_log.getFileName(), QDir::currentPath());
+    }
+}
+
+void DataManager::replayLog(quint32 typeMask, quint64 fromSequence) {
+    // The next append reopens the log, cutting off a torn tail first
+    m_checkpoint.waitForFinished();
+    m_log.close();
+    m_log.advanceSequence(fromSequence);
+    WriteAheadLog::Visitor apply = [this, typeMask, fromSequence](quint64 sequence, const char* data, int length) {
+        m_log.advanceSequence(sequence + 1);
+        quint8 type = length > 0 ? static_cast<quint8>(data[0]) : 0;
+        if (sequence >= fromSequence && type > 0 && type < 32 && (typeMask & (1u << type))) {
+            ActionEntry entry;
+            entry.assign(data, static_cast<size_t>(length));
+            applyLogEntry(entry);
+        }
+    };
+    WriteAheadLog::replay(CheckpointLogFile, apply);
+    WriteAheadLog::replay(m_log.getFileName(), apply);
 }
 
-void DataManager::saveAttendanceRecords() {
-    QFile file("attendance.txt");
-    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&file);
+void DataManager::applyLogEntry(ActionEntry& entry) {
+    switch (static_cast<LogType>(entry.getByte())) {
+        case LogType::PutEmployee:
+            addEmployee(readEmployee(entry), false);
+            break;
         
-        m_attendanceAVL->inorderTraversal([&out](const AttendanceRecord& record) {
-            out << record.toFileString() << "\n";
-        });
+        case LogType::UpdateEmployee: {
+            int id = entry.getInt();
+            updateEmployee(id, readEmployee(entry), false);
+            break;
+        }
         
-        file.close();
+        case LogType::DeleteEmployee:
+            deleteEmployee(entry.getInt(), false);
+            break;
+            
+        case LogType::SubmitLeave:
+            submitLeaveRequest(readLeaveRequest(entry));
+            break;
+        
+        case LogType::SetLeaveStatus: {
+            int employeeId = entry.getInt();
+            int position = entry.getInt();
+            LeaveStatus status = static_cast<LeaveStatus>(entry.getByte());
+            const std::vector<LeaveNode*>* bucket = m_employeeLeaveRequests.find(employeeId);
+            if (!bucket || position < 0 || position >= static_cast<int>(bucket->size())) {
+                break;
+            }
+            LeaveNode* node = (*bucket)[position];
+            LeaveHandle* handle = m_leaveIndex.find(LeaveKey::make(node->data));
+            if (handle && handle->node == node) {
+                processLeaveRequest(employeeId, node->data.getStartDate(), status, false);
+            } else {
+                // Not the indexed request for its key: only the list holds it
+                node->data.setStatus(status);
+            }
+            break;
+        }
+        
+        case LogType::PutAttendance:
+            addAttendanceRecord(readAttendance(entry));
+            break;
+            
+        case LogType::RemoveAttendance: {
+            int employeeId = entry.getInt();
+            removeAttendanceRecord(employeeId, QDate::fromJulianDay(entry.getInt()));
+            break;
+        }
+        
+        case LogType::PurgeAttendance: {
+            QDate start = QDate::fromJulianDay(entry.getInt());
+            purgeAttendance(start, QDate::fromJulianDay(entry.getInt()));
+            break;
+        }
+        
+        case LogType::ImportAttendance: {
+            int count = entry.getInt();
+            QList<AttendanceRecord> records;
+            for (int i = 0; i < count; ++i) {
+                records.append(readAttendance(entry));
+            }
+            importAttendanceRecords(records);
+            break;
+        }
     }
 }
 
@@ -435,13 +1366,17 @@ void DataManager::saveAttendanceRecords() {
 // ============================================================================
 
 int DataManager::getBSTHeight() {
-    return m_employeeBST->getHeight();
+    return m_employeeAVL->getHeight();
 }
 
 int DataManager::getAVLHeight() {
-    return m_attendanceAVL->getHeight();
+    return m_employeeAttendanceAVL->getHeight();
 }
 
 bool DataManager::isAVLBalanced() {
-    return m_attendanceAVL->isBalanced();
+    return m_employeeAttendanceAVL->isBalanced();
+}
+
+int DataManager::getBPlusTreeHeight() {
+    return m_attendanceBPlusTree->getHeight();
 }
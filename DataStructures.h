@@ -2,15 +2,278 @@
 #define DATASTRUCTURES_H
 
 #include <QString>
+#include <QByteArray>
+#include <QtAlgorithms>
+#include <QFuture>
 #include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "employee.h"
 #include "leaveRequest.h"
 #include "attendanceRecord.h"
+#include "writeAheadLog.h"
+#include "attendanceFile.h"
+
+// SSE2 is part of every x86-64 target; other targets use the scalar kernels
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ATTENDANCE_SIMD_SSE2
+#endif
+
+// ============================================================================
+// NODE ALLOCATORS - Pluggable node storage for the containers below
+// ============================================================================
+// Every node-based container takes a NodeAllocator template parameter:
+//   create(args...)  - construct a node
+//   destroy(node)    - destroy a single node and reuse its memory
+//   discard(node)    - destroy a node whose memory is released by releaseAll()
+//   releaseAll()     - release all memory; every node must be discarded first
+// needsNodeWalk tells clear() whether it must visit nodes before releaseAll().
+
+// Plain new/delete per node
+template<typename NodeT>
+class HeapNodeAllocator {
+public:
+    static const bool needsNodeWalk = true;
+    
+    template<typename... Args>
+    NodeT* create(Args&&... args) {
+        return new NodeT(std::forward<Args>(args)...);
+    }
+    
+    void destroy(NodeT* node) { delete node; }
+    void discard(NodeT* node) { delete node; }
+    void releaseAll() {}
+};
+
+// Slab allocator: nodes are carved out of contiguous blocks, freed nodes are
+// reused through a free list, and releaseAll() frees whole blocks at once.
+template<typename NodeT>
+class NodePool {
+    union Slot {
+        Slot* nextFree;
+        alignas(NodeT) unsigned char storage[sizeof(NodeT)];
+    };
+    
+    static const int FirstBlockSlots = 32;
+    static const int MaxBlockSlots = 4096;
+    
+    std::vector<Slot*> blocks;
+    Slot* freeList;
+    Slot* bumpNext;     // Next untouched slot in the newest block
+    Slot* bumpEnd;
+    int nextBlockSlots;
+    int liveNodes;
+
+public:
+    // Trivially destructible nodes need no visit at all - clear() is O(blocks)
+    static const bool needsNodeWalk = !std::is_trivially_destructible<NodeT>::value;
+    
+    NodePool()
+        : freeList(nullptr), bumpNext(nullptr), bumpEnd(nullptr),
+          nextBlockSlots(FirstBlockSlots), liveNodes(0) {}
+    
+    ~NodePool() {
+        releaseAll();
+    }
+    
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    
+    template<typename... Args>
+    NodeT* create(Args&&... args) {
+        Slot* slot = acquireSlot();
+        liveNodes++;
+        return new (slot->storage) NodeT(std::forward<Args>(args)...);
+    }
+    
+    void destroy(NodeT* node) {
+        node->~NodeT();
+        Slot* slot = reinterpret_cast<Slot*>(node);
+        slot->nextFree = freeList;
+        freeList = slot;
+        liveNodes--;
+    }
+    
+    void discard(NodeT* node) {
+        node->~NodeT();
+        liveNodes--;
+    }
+    
+    void releaseAll() {
+        for (Slot* block : blocks) {
+            ::operator delete(block);
+        }
+        blocks.clear();
+        freeList = nullptr;
+        bumpNext = bumpEnd = nullptr;
+        nextBlockSlots = FirstBlockSlots;
+        liveNodes = 0;
+    }
+    
+    // Statistics
+    int blockCount() const { return static_cast<int>(blocks.size()); }
+    int liveCount() const { return liveNodes; }
+
+private:
+    Slot* acquireSlot() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->nextFree;
+            return slot;
+        }
+        if (bumpNext == bumpEnd) {
+            // Blocks grow geometrically so large containers need few of them
+            Slot* block = static_cast<Slot*>(::operator new(sizeof(Slot) * nextBlockSlots));
+            blocks.push_back(block);
+            bumpNext = block;
+            bumpEnd = block + nextBlockSlots;
+            if (nextBlockSlots < MaxBlockSlots) {
+                nextBlockSlots *= 2;
+            }
+        }
+        return bumpNext++;
+    }
+};
+
+
+// ============================================================================
+// VISITORS - Callables accepted by the traversal templates below
+// ============================================================================
+// Traversals take any callable by template parameter so the call is inlined.
+// A visitor returning bool stops the traversal when it returns false; a
+// visitor returning void always visits everything. The std::function overloads
+// are kept as thin wrappers around the templates.
+
+template<typename Visitor, typename T>
+inline bool visitAndContinue(Visitor& visitor, const T& item) {
+    if constexpr (std::is_void<decltype(visitor(item))>::value) {
+        visitor(item);
+        return true;
+    } else {
+        return static_cast<bool>(visitor(item));
+    }
+}
+
+// ============================================================================
+// ITERATORS & VIEWS - Read-only iteration without copying
+// ============================================================================
+// Containers expose begin()/end() so range-for and <algorithm> work on them
+// directly. Iterators and views are invalidated when the container changes.
+
+// In-order iterator for BST/AVLTree: keeps the path of pending ancestors
+template<typename Node, typename T>
+class InorderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+    
+    InorderIterator() {}
+    explicit InorderIterator(Node* root) { pushLeft(root); }
+    
+    reference operator*() const { return path.back()->data; }
+    pointer operator->() const { return &(path.back()->data); }
+    
+    InorderIterator& operator++() {
+        Node* node = path.back();
+        path.pop_back();
+        pushLeft(node->right);
+        return *this;
+    }
+    
+    InorderIterator operator++(int) {
+        InorderIterator old = *this;
+        ++(*this);
+        return old;
+    }
+    
+    bool operator==(const InorderIterator& other) const { return current() == other.current(); }
+    bool operator!=(const InorderIterator& other) const { return current() != other.current(); }
+
+private:
+    void pushLeft(Node* node) {
+        while (node) {
+            path.push_back(node);
+            node = node->left;
+        }
+    }
+    
+    Node* current() const { return path.empty() ? nullptr : path.back(); }
+    
+    std::vector<Node*> path;
+};
+
+// Read-only view over a container, handed out instead of a copied QList
+template<typename Container>
+class RangeView {
+public:
+    using const_iterator = typename Container::const_iterator;
+    using iterator = const_iterator;
+    
+    explicit RangeView(const Container& c) : container(&c) {}
+    
+    const_iterator begin() const { return container->begin(); }
+    const_iterator end() const { return container->end(); }
+    int size() const { return container->size(); }
+    bool isEmpty() const { return container->isEmpty(); }
+
+private:
+    const Container* container;
+};
+
+
+// ============================================================================
+// BULK LOADING - Key order for building a tree from a whole file at once
+// ============================================================================
+// Returns (key, position) pairs in ascending key order with equal keys
+// collapsed to their last occurrence, matching insert()'s overwrite. Files are
+// saved in key order, so sorted input is detected in one pass and costs O(n);
+// anything else falls back to an O(n log n) sort.
+template<typename K, typename T, typename KeyFunction>
+std::vector<std::pair<K, int>> bulkLoadOrder(const std::vector<T>& values, const KeyFunction& keyOf) {
+    std::vector<std::pair<K, int>> order;
+    order.reserve(values.size());
+    bool sorted = true;
+    for (int i = 0; i < static_cast<int>(values.size()); i++) {
+        K key = keyOf(values[i]);
+        if (!order.empty() && key < order.back().first) {
+            sorted = false;
+        }
+        order.emplace_back(key, i);
+    }
+    
+    if (!sorted) {
+        // Ties are broken by position, which keeps equal keys in input order
+        std::sort(order.begin(), order.end());
+    }
+    
+    // Collapse runs of equal keys, keeping the last one
+    int unique = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        if (unique > 0 && !(order[unique - 1].first < order[i].first)) {
+            order[unique - 1] = order[i];
+        } else {
+            order[unique++] = order[i];
+        }
+    }
+    order.resize(unique);
+    return order;
+}
 
 // ============================================================================
 // DOUBLY LINKED LIST - For Employee Management
 // ============================================================================
-template<typename T>
+template<typename T, template<typename> class NodeAllocator = NodePool>
 class DoublyLinkedList {
 public:
     struct Node {
@@ -25,8 +288,62 @@ private:
     Node* head;
     Node* tail;
     int count;
+    NodeAllocator<Node> nodeAlloc;
 
 public:
+    // Bidirectional iterator; end() can be decremented to reach the tail
+    class const_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator() : node(nullptr), list(nullptr) {}
+        
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &(node->data); }
+        
+        const_iterator& operator++() {
+            node = node->next;
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            node = node->next;
+            return old;
+        }
+        
+        const_iterator& operator--() {
+            node = node ? node->prev : list->tail;
+            return *this;
+        }
+        
+        const_iterator operator--(int) {
+            const_iterator old = *this;
+            --(*this);
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+    
+    private:
+        friend class DoublyLinkedList;
+        const_iterator(Node* n, const DoublyLinkedList* l) : node(n), list(l) {}
+        
+        Node* node;
+        const DoublyLinkedList* list;
+    };
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    
+    const_iterator begin() const { return const_iterator(head, this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    
     DoublyLinkedList() : head(nullptr), tail(nullptr), count(0) {}
     
     ~DoublyLinkedList() {
@@ -55,9 +372,9 @@ public:
         return *this;
     }
     
-    // Insert at beginning
-    void insertAtBeginning(const T& value) {
-        Node* newNode = new Node(value);
+    // Insert at beginning; returns the node as a handle for unlink()
+    Node* insertAtBeginning(const T& value) {
+        Node* newNode = nodeAlloc.create(value);
         if (!head) {
             head = tail = newNode;
         } else {
@@ -66,11 +383,12 @@ public:
             head = newNode;
         }
         count++;
+        return newNode;
     }
     
-    // Insert at end
-    void insertAtEnd(const T& value) {
-        Node* newNode = new Node(value);
+    // Insert at end; returns the node as a handle for unlink()
+    Node* insertAtEnd(const T& value) {
+        Node* newNode = nodeAlloc.create(value);
         if (!tail) {
             head = tail = newNode;
         } else {
@@ -79,6 +397,7 @@ public:
             tail = newNode;
         }
         count++;
+        return newNode;
     }
     
     // Insert at position
@@ -97,7 +416,7 @@ public:
             current = current->next;
         }
         
-        Node* newNode = new Node(value);
+        Node* newNode = nodeAlloc.create(value);
         newNode->next = current->next;
         newNode->prev = current;
         current->next->prev = newNode;
@@ -116,7 +435,7 @@ public:
             head = head->next;
             head->prev = nullptr;
         }
-        delete temp;
+        nodeAlloc.destroy(temp);
         count--;
         return true;
     }
@@ -132,7 +451,7 @@ public:
             tail = tail->prev;
             tail->next = nullptr;
         }
-        delete temp;
+        nodeAlloc.destroy(temp);
         count--;
         return true;
     }
@@ -150,27 +469,48 @@ public:
         
         current->prev->next = current->next;
         current->next->prev = current->prev;
-        delete current;
+        nodeAlloc.destroy(current);
         count--;
         return true;
     }
     
+    // Remove a node of this list in O(1); the handle is invalid afterwards
+    void unlink(Node* node) {
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            head = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        } else {
+            tail = node->prev;
+        }
+        nodeAlloc.destroy(node);
+        count--;
+    }
+    
     // Delete by value using comparator
-    bool deleteByValue(const T& value, std::function<bool(const T&, const T&)> compare) {
+    template<typename Compare>
+    bool deleteByValue(const T& value, Compare&& compare) {
         Node* current = head;
-        int position = 0;
         while (current) {
             if (compare(current->data, value)) {
-                return deleteAt(position);
+                unlink(current);
+                return true;
             }
             current = current->next;
-            position++;
         }
         return false;
     }
     
+    bool deleteByValue(const T& value, std::function<bool(const T&, const T&)> compare) {
+        return deleteByValue<std::function<bool(const T&, const T&)>&>(value, compare);
+    }
+    
     // Find by condition
-    T* find(std::function<bool(const T&)> condition) {
+    template<typename Predicate>
+    T* find(Predicate&& condition) {
         Node* current = head;
         while (current) {
             if (condition(current->data)) {
@@ -181,8 +521,13 @@ public:
         return nullptr;
     }
     
+    T* find(std::function<bool(const T&)> condition) {
+        return find<std::function<bool(const T&)>&>(condition);
+    }
+    
     // Update element
-    bool update(std::function<bool(const T&)> condition, const T& newValue) {
+    template<typename Predicate>
+    bool update(Predicate&& condition, const T& newValue) {
         Node* current = head;
         while (current) {
             if (condition(current->data)) {
@@ -194,6 +539,10 @@ public:
         return false;
     }
     
+    bool update(std::function<bool(const T&)> condition, const T& newValue) {
+        return update<std::function<bool(const T&)>&>(condition, newValue);
+    }
+    
     // Get at position
     T* getAt(int position) {
         if (position < 0 || position >= count) return nullptr;
@@ -205,22 +554,34 @@ public:
         return &(current->data);
     }
     
-    // Forward traversal
-    void traverseForward(std::function<void(const T&)> action) const {
+    // Forward traversal; returns false if the visitor stopped early
+    template<typename Visitor>
+    bool traverseForward(Visitor&& visitor) const {
         Node* current = head;
         while (current) {
-            action(current->data);
+            if (!visitAndContinue(visitor, current->data)) return false;
             current = current->next;
         }
+        return true;
     }
     
-    // Backward traversal
-    void traverseBackward(std::function<void(const T&)> action) const {
+    void traverseForward(std::function<void(const T&)> action) const {
+        traverseForward<std::function<void(const T&)>&>(action);
+    }
+    
+    // Backward traversal; returns false if the visitor stopped early
+    template<typename Visitor>
+    bool traverseBackward(Visitor&& visitor) const {
         Node* current = tail;
         while (current) {
-            action(current->data);
+            if (!visitAndContinue(visitor, current->data)) return false;
             current = current->prev;
         }
+        return true;
+    }
+    
+    void traverseBackward(std::function<void(const T&)> action) const {
+        traverseBackward<std::function<void(const T&)>&>(action);
     }
     
     // Get size
@@ -229,14 +590,17 @@ public:
     // Check if empty
     bool isEmpty() const { return count == 0; }
     
-    // Clear list
+    // Clear list (pooled nodes are released block by block)
     void clear() {
-        while (head) {
-            Node* temp = head;
-            head = head->next;
-            delete temp;
+        if (NodeAllocator<Node>::needsNodeWalk) {
+            while (head) {
+                Node* temp = head;
+                head = head->next;
+                nodeAlloc.discard(temp);
+            }
         }
-        tail = nullptr;
+        nodeAlloc.releaseAll();
+        head = tail = nullptr;
         count = 0;
     }
     
@@ -260,10 +624,190 @@ public:
 
 
 // ============================================================================
-// STACK - For Undo/Redo Operations
+// RING BUFFER - Contiguous Double-Ended Storage for Stack and Queue
 // ============================================================================
+// Elements live in one power-of-two array addressed from a moving head, so
+// both ends push and pop in O(1) and the buffer doubles when full (amortized
+// O(1)). T must be default-constructible; vacated slots are reset to T() so
+// they release what they held.
 template<typename T>
-class Stack {
+class RingBuffer {
+public:
+    // Forward iterator from front to back
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator() : ring(nullptr), index(0) {}
+        const_iterator(const RingBuffer* r, int i) : ring(r), index(i) {}
+        
+        reference operator*() const { return (*ring)[index]; }
+        pointer operator->() const { return &(*ring)[index]; }
+        
+        const_iterator& operator++() {
+            index++;
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            index++;
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    
+    private:
+        const RingBuffer* ring;
+        int index;
+    };
+    
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+    
+    RingBuffer() : head(0), count(0) {}
+    
+    void pushBack(const T& value) {
+        if (count == capacity()) {
+            grow(count + 1);
+        }
+        cells[slotFor(count)] = value;
+        count++;
+    }
+    
+    void pushFront(const T& value) {
+        if (count == capacity()) {
+            grow(count + 1);
+        }
+        head = (head - 1) & (capacity() - 1);
+        cells[head] = value;
+        count++;
+    }
+    
+    bool popBack(T& value) {
+        if (count == 0) return false;
+        T& slot = cells[slotFor(count - 1)];
+        value = std::move(slot);
+        slot = T();
+        count--;
+        return true;
+    }
+    
+    bool popFront(T& value) {
+        if (count == 0) return false;
+        value = std::move(cells[head]);
+        dropFront();
+        return true;
+    }
+    
+    // Discard the oldest element without copying it out
+    void dropFront() {
+        if (count == 0) return;
+        cells[head] = T();
+        head = (head + 1) & (capacity() - 1);
+        count--;
+    }
+    
+    // Remove the element at a logical position, shifting the shorter side
+    void removeAt(int index) {
+        if (index < 0 || index >= count) return;
+        if (index < count / 2) {
+            for (int i = index; i > 0; i--) {
+                cells[slotFor(i)] = std::move(cells[slotFor(i - 1)]);
+            }
+            dropFront();
+        } else {
+            for (int i = index; i < count - 1; i++) {
+                cells[slotFor(i)] = std::move(cells[slotFor(i + 1)]);
+            }
+            cells[slotFor(count - 1)] = T();
+            count--;
+        }
+    }
+    
+    // Element at a logical position (0 = front); index must be in range
+    T& operator[](int index) { return cells[slotFor(index)]; }
+    const T& operator[](int index) const { return cells[slotFor(index)]; }
+    
+    T& front() { return cells[head]; }
+    const T& front() const { return cells[head]; }
+    T& back() { return cells[slotFor(count - 1)]; }
+    const T& back() const { return cells[slotFor(count - 1)]; }
+    
+    // Make room for at least n elements without further growth
+    void reserve(int n) {
+        if (n > capacity()) {
+            grow(n);
+        }
+    }
+    
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    int capacity() const { return static_cast<int>(cells.size()); }
+    
+    // Remove all elements (capacity is kept)
+    void clear() {
+        for (int i = 0; i < count; i++) {
+            cells[slotFor(i)] = T();
+        }
+        head = 0;
+        count = 0;
+    }
+
+private:
+    int slotFor(int index) const {
+        return (head + index) & (capacity() - 1);
+    }
+    
+    // Move into a power-of-two array of at least minCapacity, front at slot 0
+    void grow(int minCapacity) {
+        int newCapacity = capacity() > 0 ? capacity() : 8;
+        while (newCapacity < minCapacity) {
+            newCapacity *= 2;
+        }
+        std::vector<T> bigger(newCapacity);
+        for (int i = 0; i < count; i++) {
+            bigger[i] = std::move(cells[slotFor(i)]);
+        }
+        cells.swap(bigger);
+        head = 0;
+    }
+    
+    std::vector<T> cells;
+    int head;
+    int count;
+};
+
+
+// ============================================================================
+// STORAGE POLICIES - Element storage for Stack and Queue
+// ============================================================================
+// LinkedStorage keeps one node per element (from the given NodeAllocator) and
+// supports node handles; RingStorage keeps elements contiguous in a RingBuffer.
+template<template<typename> class NodeAllocator = NodePool>
+struct LinkedStorage {};
+
+struct RingStorage {};
+
+template<typename T, typename Storage = LinkedStorage<>>
+class Stack;
+
+template<typename T, typename Storage = LinkedStorage<>>
+class Queue;
+
+
+// ============================================================================
+// STACK - Bounded LIFO Container
+// ============================================================================
+// Library API: DataManager keeps undo/redo history in ActionLog instead.
+// Linked storage: one node per element
+template<typename T, template<typename> class NodeAllocator>
+class Stack<T, LinkedStorage<NodeAllocator>> {
 public:
     struct Node {
         T data;
@@ -276,6 +820,7 @@ private:
     Node* topNode;
     int count;
     int maxSize;
+    NodeAllocator<Node> nodeAlloc;
 
 public:
     Stack(int maxCapacity = 50) : topNode(nullptr), count(0), maxSize(maxCapacity) {}
@@ -291,7 +836,7 @@ public:
             removeBottom();
         }
         
-        Node* newNode = new Node(value);
+        Node* newNode = nodeAlloc.create(value);
         newNode->next = topNode;
         topNode = newNode;
         count++;
@@ -304,7 +849,7 @@ public:
         value = topNode->data;
         Node* temp = topNode;
         topNode = topNode->next;
-        delete temp;
+        nodeAlloc.destroy(temp);
         count--;
         return true;
     }
@@ -324,11 +869,15 @@ public:
     
     // Clear stack
     void clear() {
-        while (topNode) {
-            Node* temp = topNode;
-            topNode = topNode->next;
-            delete temp;
+        if (NodeAllocator<Node>::needsNodeWalk) {
+            while (topNode) {
+                Node* temp = topNode;
+                topNode = topNode->next;
+                nodeAlloc.discard(temp);
+            }
         }
+        nodeAlloc.releaseAll();
+        topNode = nullptr;
         count = 0;
     }
 
@@ -336,7 +885,7 @@ private:
     void removeBottom() {
         if (!topNode) return;
         if (!topNode->next) {
-            delete topNode;
+            nodeAlloc.destroy(topNode);
             topNode = nullptr;
             count = 0;
             return;
@@ -346,48 +895,134 @@ private:
         while (current->next->next) {
             current = current->next;
         }
-        delete current->next;
+        nodeAlloc.destroy(current->next);
         current->next = nullptr;
         count--;
     }
 };
 
+// Ring-buffer storage: contiguous, and dropping the oldest entry at capacity
+// is O(1) instead of a walk to the bottom of the list
+template<typename T>
+class Stack<T, RingStorage> {
+private:
+    RingBuffer<T> ring;     // Front is the bottom of the stack
+    int maxSize;
+
+public:
+    Stack(int maxCapacity = 50) : maxSize(maxCapacity) {}
+    
+    // Push element
+    void push(const T& value) {
+        // If stack is full, drop the bottom element
+        if (ring.size() >= maxSize) {
+            ring.dropFront();
+        }
+        ring.pushBack(value);
+    }
+    
+    // Pop element
+    bool pop(T& value) {
+        return ring.popBack(value);
+    }
+    
+    // Peek top element
+    bool peek(T& value) const {
+        if (ring.isEmpty()) return false;
+        value = ring.back();
+        return true;
+    }
+    
+    // Check if empty
+    bool isEmpty() const { return ring.isEmpty(); }
+    
+    // Get size
+    int size() const { return ring.size(); }
+    
+    // Clear stack (buffer capacity is kept)
+    void clear() {
+        ring.clear();
+    }
+};
+
 
 // ============================================================================
-// QUEUE - For Leave Request Processing (FIFO)
+// QUEUE - FIFO Container
 // ============================================================================
-template<typename T>
-class Queue {
+// Library API: DataManager keeps pending leave requests in IndexedHeap instead.
+// Linked storage: one node per element, with O(1) unlink() through node handles
+template<typename T, template<typename> class NodeAllocator>
+class Queue<T, LinkedStorage<NodeAllocator>> {
 public:
     struct Node {
         T data;
+        Node* prev;     // Lets unlink() remove a node from the middle in O(1)
         Node* next;
         
-        Node(const T& value) : data(value), next(nullptr) {}
+        Node(const T& value) : data(value), prev(nullptr), next(nullptr) {}
     };
 
 private:
     Node* front;
     Node* rear;
     int count;
+    NodeAllocator<Node> nodeAlloc;
 
 public:
+    // Forward iterator from front to rear
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator() : node(nullptr) {}
+        explicit const_iterator(Node* n) : node(n) {}
+        
+        reference operator*() const { return node->data; }
+        pointer operator->() const { return &(node->data); }
+        
+        const_iterator& operator++() {
+            node = node->next;
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            node = node->next;
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const { return node == other.node; }
+        bool operator!=(const const_iterator& other) const { return node != other.node; }
+    
+    private:
+        Node* node;
+    };
+    
+    const_iterator begin() const { return const_iterator(front); }
+    const_iterator end() const { return const_iterator(); }
+    
     Queue() : front(nullptr), rear(nullptr), count(0) {}
     
     ~Queue() {
         clear();
     }
     
-    // Enqueue element
-    void enqueue(const T& value) {
-        Node* newNode = new Node(value);
+    // Enqueue element; returns the node as a handle for unlink()
+    Node* enqueue(const T& value) {
+        Node* newNode = nodeAlloc.create(value);
         if (!rear) {
             front = rear = newNode;
         } else {
+            newNode->prev = rear;
             rear->next = newNode;
             rear = newNode;
         }
         count++;
+        return newNode;
     }
     
     // Dequeue element
@@ -399,18 +1034,36 @@ public:
         front = front->next;
         if (!front) {
             rear = nullptr;
+        } else {
+            front->prev = nullptr;
         }
-        delete temp;
+        nodeAlloc.destroy(temp);
         count--;
         return true;
     }
     
-    // Peek front element
-    bool peek(T& value) const {
-        if (!front) return false;
-        value = front->data;
-        return true;
-    }
+    // Remove a node of this queue in O(1); the handle is invalid afterwards
+    void unlink(Node* node) {
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            front = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        } else {
+            rear = node->prev;
+        }
+        nodeAlloc.destroy(node);
+        count--;
+    }
+    
+    // Peek front element
+    bool peek(T& value) const {
+        if (!front) return false;
+        value = front->data;
+        return true;
+    }
     
     // Check if empty
     bool isEmpty() const { return count == 0; }
@@ -420,25 +1073,34 @@ public:
     
     // Clear queue
     void clear() {
-        while (front) {
-            Node* temp = front;
-            front = front->next;
-            delete temp;
+        if (NodeAllocator<Node>::needsNodeWalk) {
+            while (front) {
+                Node* temp = front;
+                front = front->next;
+                nodeAlloc.discard(temp);
+            }
         }
-        rear = nullptr;
+        nodeAlloc.releaseAll();
+        front = rear = nullptr;
         count = 0;
     }
     
     // Get front node for iteration
     Node* getFront() const { return front; }
     
-    // Traverse queue
-    void traverse(std::function<void(const T&)> action) const {
+    // Traverse queue; returns false if the visitor stopped early
+    template<typename Visitor>
+    bool traverse(Visitor&& visitor) const {
         Node* current = front;
         while (current) {
-            action(current->data);
+            if (!visitAndContinue(visitor, current->data)) return false;
             current = current->next;
         }
+        return true;
+    }
+    
+    void traverse(std::function<void(const T&)> action) const {
+        traverse<std::function<void(const T&)>&>(action);
     }
     
     // Convert to QList
@@ -453,28 +1115,12 @@ public:
     }
     
     // Remove by condition
-    bool removeByCondition(std::function<bool(const T&)> condition) {
-        if (!front) return false;
-        
-        // Check front
-        if (condition(front->data)) {
-            Node* temp = front;
-            front = front->next;
-            if (!front) rear = nullptr;
-            delete temp;
-            count--;
-            return true;
-        }
-        
-        // Check rest
+    template<typename Predicate>
+    bool removeByCondition(Predicate&& condition) {
         Node* current = front;
-        while (current->next) {
-            if (condition(current->next->data)) {
-                Node* temp = current->next;
-                current->next = temp->next;
-                if (temp == rear) rear = current;
-                delete temp;
-                count--;
+        while (current) {
+            if (condition(current->data)) {
+                unlink(current);
                 return true;
             }
             current = current->next;
@@ -482,8 +1128,13 @@ public:
         return false;
     }
     
+    bool removeByCondition(std::function<bool(const T&)> condition) {
+        return removeByCondition<std::function<bool(const T&)>&>(condition);
+    }
+    
     // Update by condition
-    bool updateByCondition(std::function<bool(const T&)> condition, const T& newValue) {
+    template<typename Predicate>
+    bool updateByCondition(Predicate&& condition, const T& newValue) {
         Node* current = front;
         while (current) {
             if (condition(current->data)) {
@@ -494,13 +1145,331 @@ public:
         }
         return false;
     }
+    
+    bool updateByCondition(std::function<bool(const T&)> condition, const T& newValue) {
+        return updateByCondition<std::function<bool(const T&)>&>(condition, newValue);
+    }
+};
+
+// Ring-buffer storage: contiguous, no allocation per element. No node
+// handles, so there is no unlink(); removeByCondition shifts the shorter side.
+template<typename T>
+class Queue<T, RingStorage> {
+private:
+    RingBuffer<T> ring;
+
+public:
+    using const_iterator = typename RingBuffer<T>::const_iterator;
+    
+    const_iterator begin() const { return ring.begin(); }
+    const_iterator end() const { return ring.end(); }
+    
+    // Enqueue element
+    void enqueue(const T& value) {
+        ring.pushBack(value);
+    }
+    
+    // Dequeue element
+    bool dequeue(T& value) {
+        return ring.popFront(value);
+    }
+    
+    // Peek front element
+    bool peek(T& value) const {
+        if (ring.isEmpty()) return false;
+        value = ring.front();
+        return true;
+    }
+    
+    // Check if empty
+    bool isEmpty() const { return ring.isEmpty(); }
+    
+    // Get size
+    int size() const { return ring.size(); }
+    
+    // Clear queue (buffer capacity is kept)
+    void clear() {
+        ring.clear();
+    }
+    
+    // Traverse queue; returns false if the visitor stopped early
+    template<typename Visitor>
+    bool traverse(Visitor&& visitor) const {
+        for (int i = 0; i < ring.size(); i++) {
+            if (!visitAndContinue(visitor, ring[i])) return false;
+        }
+        return true;
+    }
+    
+    void traverse(std::function<void(const T&)> action) const {
+        traverse<std::function<void(const T&)>&>(action);
+    }
+    
+    // Convert to QList
+    QList<T> toQList() const {
+        QList<T> list;
+        list.reserve(ring.size());
+        for (int i = 0; i < ring.size(); i++) {
+            list.append(ring[i]);
+        }
+        return list;
+    }
+    
+    // Remove by condition
+    template<typename Predicate>
+    bool removeByCondition(Predicate&& condition) {
+        for (int i = 0; i < ring.size(); i++) {
+            if (condition(ring[i])) {
+                ring.removeAt(i);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    bool removeByCondition(std::function<bool(const T&)> condition) {
+        return removeByCondition<std::function<bool(const T&)>&>(condition);
+    }
+    
+    // Update by condition
+    template<typename Predicate>
+    bool updateByCondition(Predicate&& condition, const T& newValue) {
+        for (int i = 0; i < ring.size(); i++) {
+            if (condition(ring[i])) {
+                ring[i] = newValue;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    bool updateByCondition(std::function<bool(const T&)> condition, const T& newValue) {
+        return updateByCondition<std::function<bool(const T&)>&>(condition, newValue);
+    }
+};
+
+
+// ============================================================================
+// INDEXED HEAP - Priority Queue with Handles for Pending Leave Requests
+// ============================================================================
+// Binary min-heap of handles. push() returns a stable handle that can later
+// be used to remove or update the entry in O(log n). Priority is a cached
+// integer key from a configurable key function (smaller = sooner); equal keys
+// keep insertion order, so with no key function the heap is plain FIFO.
+template<typename T>
+class IndexedHeap {
+public:
+    typedef int Handle;                                     // -1 = no entry
+    typedef std::function<qint64(const T&)> KeyFunction;
+
+private:
+    struct Entry {
+        T value;
+        qint64 key;
+        quint64 seq;        // Insertion order, breaks ties between equal keys
+        int heapIndex;      // Position in heap, -1 when the handle is free
+    };
+    
+    std::vector<Entry> entries;         // Indexed by handle
+    std::vector<Handle> freeHandles;
+    std::vector<Handle> heap;           // Heap order
+    KeyFunction keyFunction;
+    quint64 nextSeq;
+
+public:
+    IndexedHeap() : nextSeq(0) {}
+    
+    // Insert element; returns its handle
+    Handle push(const T& value) {
+        Handle handle;
+        if (!freeHandles.empty()) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+            entries[handle].value = value;
+        } else {
+            handle = static_cast<Handle>(entries.size());
+            entries.push_back(Entry{value, 0, 0, -1});
+        }
+        
+        Entry& entry = entries[handle];
+        entry.key = keyFor(value);
+        entry.seq = nextSeq++;
+        
+        heap.push_back(handle);
+        siftUp(static_cast<int>(heap.size()) - 1);
+        return handle;
+    }
+    
+    // Peek top element
+    bool peek(T& value) const {
+        if (heap.empty()) return false;
+        value = entries[heap[0]].value;
+        return true;
+    }
+    
+    const T* top() const {
+        return heap.empty() ? nullptr : &(entries[heap[0]].value);
+    }
+    
+    // Remove top element
+    bool pop(T& value) {
+        if (heap.empty()) return false;
+        value = entries[heap[0]].value;
+        return remove(heap[0]);
+    }
+    
+    // Remove by handle: O(log n)
+    bool remove(Handle handle) {
+        if (!contains(handle)) return false;
+        
+        int index = entries[handle].heapIndex;
+        Handle last = heap.back();
+        heap.pop_back();
+        
+        entries[handle].heapIndex = -1;
+        entries[handle].value = T();
+        freeHandles.push_back(handle);
+        
+        if (last != handle) {
+            place(index, last);
+            siftUp(index);
+            siftDown(entries[last].heapIndex);
+        }
+        return true;
+    }
+    
+    // Replace value (and so its priority) by handle: O(log n)
+    bool update(Handle handle, const T& value) {
+        if (!contains(handle)) return false;
+        
+        Entry& entry = entries[handle];
+        entry.value = value;
+        entry.key = keyFor(value);
+        siftUp(entry.heapIndex);
+        siftDown(entry.heapIndex);
+        return true;
+    }
+    
+    // Value by handle
+    const T* get(Handle handle) const {
+        return contains(handle) ? &(entries[handle].value) : nullptr;
+    }
+    
+    bool contains(Handle handle) const {
+        return handle >= 0 && handle < static_cast<int>(entries.size()) &&
+               entries[handle].heapIndex >= 0;
+    }
+    
+    // Change the ordering; keys are recomputed and the heap rebuilt in place, O(n)
+    void setKeyFunction(KeyFunction function) {
+        keyFunction = function;
+        for (Handle handle : heap) {
+            entries[handle].key = keyFor(entries[handle].value);
+        }
+        for (int i = static_cast<int>(heap.size()) / 2 - 1; i >= 0; i--) {
+            siftDown(i);
+        }
+    }
+    
+    // Visit the k highest-priority elements in order without popping them:
+    // O(k log k) using a frontier of candidate heap positions
+    template<typename Visitor>
+    bool visitTop(int k, Visitor&& visitor) const {
+        if (heap.empty() || k <= 0) return true;
+        
+        // std heap functions build a max-heap, so "less" means "comes later"
+        auto later = [this](int a, int b) { return before(heap[b], heap[a]); };
+        std::vector<int> frontier;
+        frontier.push_back(0);
+        
+        for (int visited = 0; visited < k && !frontier.empty(); visited++) {
+            std::pop_heap(frontier.begin(), frontier.end(), later);
+            int index = frontier.back();
+            frontier.pop_back();
+            
+            if (!visitAndContinue(visitor, entries[heap[index]].value)) return false;
+            
+            for (int child = 2 * index + 1; child <= 2 * index + 2; child++) {
+                if (child < static_cast<int>(heap.size())) {
+                    frontier.push_back(child);
+                    std::push_heap(frontier.begin(), frontier.end(), later);
+                }
+            }
+        }
+        return true;
+    }
+    
+    // Convert to QList in priority order
+    QList<T> toQList() const {
+        QList<T> list;
+        list.reserve(size());
+        visitTop(size(), [&list](const T& item) {
+            list.append(item);
+        });
+        return list;
+    }
+    
+    // Get size
+    int size() const { return static_cast<int>(heap.size()); }
+    
+    // Check if empty
+    bool isEmpty() const { return heap.empty(); }
+    
+    // Clear heap (the key function is kept)
+    void clear() {
+        entries.clear();
+        freeHandles.clear();
+        heap.clear();
+        nextSeq = 0;
+    }
+
+private:
+    qint64 keyFor(const T& value) const {
+        return keyFunction ? keyFunction(value) : 0;
+    }
+    
+    bool before(Handle a, Handle b) const {
+        const Entry& x = entries[a];
+        const Entry& y = entries[b];
+        return x.key < y.key || (x.key == y.key && x.seq < y.seq);
+    }
+    
+    void place(int index, Handle handle) {
+        heap[index] = handle;
+        entries[handle].heapIndex = index;
+    }
+    
+    void siftUp(int index) {
+        Handle handle = heap[index];
+        while (index > 0) {
+            int parent = (index - 1) / 2;
+            if (!before(handle, heap[parent])) break;
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, handle);
+    }
+    
+    void siftDown(int index) {
+        Handle handle = heap[index];
+        int n = static_cast<int>(heap.size());
+        while (true) {
+            int child = 2 * index + 1;
+            if (child >= n) break;
+            if (child + 1 < n && before(heap[child + 1], heap[child])) child++;
+            if (!before(heap[child], handle)) break;
+            place(index, heap[child]);
+            index = child;
+        }
+        place(index, handle);
+    }
 };
 
 
 // ============================================================================
 // BINARY SEARCH TREE (BST) - For Employee Search by ID
 // ============================================================================
-template<typename T, typename K>
+template<typename T, typename K, template<typename> class NodeAllocator = NodePool>
 class BST {
 public:
     struct Node {
@@ -508,46 +1477,118 @@ public:
         K key;
         Node* left;
         Node* right;
+        int height;     // Cached so getHeight() is O(1)
         
-        Node(const T& value, const K& k) : data(value), key(k), left(nullptr), right(nullptr) {}
+        Node(const T& value, const K& k) : data(value), key(k), left(nullptr), right(nullptr), height(1) {}
     };
 
 private:
     Node* root;
     int count;
     std::function<K(const T&)> keyExtractor;
+    NodeAllocator<Node> nodeAlloc;
+    std::vector<Node**> path;   // Links walked by insert/remove, reused between calls
 
 public:
+    // In-order (ascending key) iteration
+    using const_iterator = InorderIterator<Node, T>;
+    
+    const_iterator begin() const { return const_iterator(root); }
+    const_iterator end() const { return const_iterator(); }
+    
     BST(std::function<K(const T&)> extractor) : root(nullptr), count(0), keyExtractor(extractor) {}
     
     ~BST() {
         clear();
     }
     
-    // Insert element
+    // Insert element (existing key is updated in place). Iterative, so a
+    // degenerate tree built from sorted input cannot overflow the call stack.
     void insert(const T& value) {
         K key = keyExtractor(value);
-        root = insertRecursive(root, value, key);
+        path.clear();
+        Node** link = &root;
+        while (*link) {
+            Node* node = *link;
+            if (key < node->key) {
+                path.push_back(link);
+                link = &node->left;
+            } else if (key > node->key) {
+                path.push_back(link);
+                link = &node->right;
+            } else {
+                // Key exists, update value
+                node->data = value;
+                return;
+            }
+        }
+        
+        *link = nodeAlloc.create(value, key);
         count++;
+        refreshHeights();
     }
     
     // Search by key
     T* search(const K& key) {
-        Node* result = searchRecursive(root, key);
+        Node* result = findNode(key);
         return result ? &(result->data) : nullptr;
     }
     
+    // Replace the contents with a perfectly balanced tree built from values:
+    // O(n) for input already in key order, O(n log n) otherwise
+    void bulkLoad(const std::vector<T>& values) {
+        clear();
+        std::vector<std::pair<K, int>> order = bulkLoadOrder<K>(values, keyExtractor);
+        root = buildBalanced(values, order, 0, static_cast<int>(order.size()) - 1);
+        count = static_cast<int>(order.size());
+    }
+    
     // Delete by key
     bool remove(const K& key) {
-        if (!search(key)) return false;
-        root = deleteRecursive(root, key);
+        path.clear();
+        Node** link = &root;
+        while (*link) {
+            Node* node = *link;
+            if (key < node->key) {
+                path.push_back(link);
+                link = &node->left;
+            } else if (key > node->key) {
+                path.push_back(link);
+                link = &node->right;
+            } else {
+                break;
+            }
+        }
+        
+        Node* node = *link;
+        if (!node) return false;
+        
+        if (node->left && node->right) {
+            // Node has two children: take over the in-order successor's
+            // entry and unlink the successor instead
+            path.push_back(link);
+            Node** successorLink = &node->right;
+            while ((*successorLink)->left) {
+                path.push_back(successorLink);
+                successorLink = &(*successorLink)->left;
+            }
+            Node* successor = *successorLink;
+            node->data = successor->data;
+            node->key = successor->key;
+            link = successorLink;
+            node = successor;
+        }
+        
+        *link = node->left ? node->left : node->right;
+        nodeAlloc.destroy(node);
         count--;
+        refreshHeights();
         return true;
     }
     
     // Update element
     bool update(const K& key, const T& newValue) {
-        Node* node = searchRecursive(root, key);
+        Node* node = findNode(key);
         if (node) {
             node->data = newValue;
             return true;
@@ -555,19 +1596,73 @@ public:
         return false;
     }
     
-    // In-order traversal (sorted order)
+    // In-order traversal (sorted order); returns false if stopped early
+    template<typename Visitor>
+    bool inorderTraversal(Visitor&& visitor) const {
+        std::vector<Node*> stack;
+        Node* node = root;
+        while (node || !stack.empty()) {
+            while (node) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            if (!visitAndContinue(visitor, node->data)) return false;
+            node = node->right;
+        }
+        return true;
+    }
+    
     void inorderTraversal(std::function<void(const T&)> action) const {
-        inorderRecursive(root, action);
+        inorderTraversal<std::function<void(const T&)>&>(action);
     }
     
     // Pre-order traversal
+    template<typename Visitor>
+    bool preorderTraversal(Visitor&& visitor) const {
+        std::vector<Node*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            if (!visitAndContinue(visitor, node->data)) return false;
+            if (node->right) stack.push_back(node->right);
+            if (node->left) stack.push_back(node->left);
+        }
+        return true;
+    }
+    
     void preorderTraversal(std::function<void(const T&)> action) const {
-        preorderRecursive(root, action);
+        preorderTraversal<std::function<void(const T&)>&>(action);
     }
     
     // Post-order traversal
+    template<typename Visitor>
+    bool postorderTraversal(Visitor&& visitor) const {
+        std::vector<Node*> stack;
+        Node* node = root;
+        Node* lastVisited = nullptr;
+        while (node || !stack.empty()) {
+            while (node) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            Node* top = stack.back();
+            if (top->right && top->right != lastVisited) {
+                // Right subtree still pending
+                node = top->right;
+            } else {
+                if (!visitAndContinue(visitor, top->data)) return false;
+                lastVisited = top;
+                stack.pop_back();
+            }
+        }
+        return true;
+    }
+    
     void postorderTraversal(std::function<void(const T&)> action) const {
-        postorderRecursive(root, action);
+        postorderTraversal<std::function<void(const T&)>&>(action);
     }
     
     // Get size
@@ -598,12 +1693,15 @@ public:
     
     // Get height
     int getHeight() const {
-        return heightRecursive(root);
+        return nodeHeight(root);
     }
     
     // Clear tree
     void clear() {
-        clearRecursive(root);
+        if (NodeAllocator<Node>::needsNodeWalk) {
+            discardAll();
+        }
+        nodeAlloc.releaseAll();
         root = nullptr;
         count = 0;
     }
@@ -618,101 +1716,61 @@ public:
     }
 
 private:
-    Node* insertRecursive(Node* node, const T& value, const K& key) {
-        if (!node) {
-            return new Node(value, key);
-        }
-        
-        if (key < node->key) {
-            node->left = insertRecursive(node->left, value, key);
-        } else if (key > node->key) {
-            node->right = insertRecursive(node->right, value, key);
-        } else {
-            // Key exists, update value
-            node->data = value;
-            count--; // Compensate for the increment in insert()
-        }
-        
-        return node;
+    static int nodeHeight(Node* node) {
+        return node ? node->height : 0;
     }
     
-    Node* searchRecursive(Node* node, const K& key) const {
-        if (!node || node->key == key) {
-            return node;
-        }
-        
-        if (key < node->key) {
-            return searchRecursive(node->left, key);
+    // Recompute heights bottom-up along the recorded path, stopping at the
+    // first node whose height did not change
+    void refreshHeights() {
+        while (!path.empty()) {
+            Node* node = *path.back();
+            path.pop_back();
+            int height = 1 + std::max(nodeHeight(node->left), nodeHeight(node->right));
+            if (height == node->height) break;
+            node->height = height;
         }
-        return searchRecursive(node->right, key);
+        path.clear();
     }
     
-    Node* deleteRecursive(Node* node, const K& key) {
-        if (!node) return nullptr;
-        
-        if (key < node->key) {
-            node->left = deleteRecursive(node->left, key);
-        } else if (key > node->key) {
-            node->right = deleteRecursive(node->right, key);
-        } else {
-            // Node to delete found
-            if (!node->left) {
-                Node* temp = node->right;
-                delete node;
-                return temp;
-            } else if (!node->right) {
-                Node* temp = node->left;
-                delete node;
-                return temp;
-            }
-            
-            // Node has two children
-            Node* minRight = node->right;
-            while (minRight->left) {
-                minRight = minRight->left;
-            }
-            
-            node->data = minRight->data;
-            node->key = minRight->key;
-            node->right = deleteRecursive(node->right, minRight->key);
-        }
-        
+    // Middle element becomes the root; nodes are allocated in key order so
+    // in-order walks touch the pool sequentially. Recursion depth is log2 n.
+    Node* buildBalanced(const std::vector<T>& values, const std::vector<std::pair<K, int>>& order,
+                        int low, int high) {
+        if (low > high) return nullptr;
+        int mid = low + (high - low) / 2;
+        Node* left = buildBalanced(values, order, low, mid - 1);
+        Node* node = nodeAlloc.create(values[order[mid].second], order[mid].first);
+        node->left = left;
+        node->right = buildBalanced(values, order, mid + 1, high);
+        node->height = 1 + std::max(nodeHeight(node->left), nodeHeight(node->right));
         return node;
     }
     
-    void inorderRecursive(Node* node, std::function<void(const T&)> action) const {
-        if (!node) return;
-        inorderRecursive(node->left, action);
-        action(node->data);
-        inorderRecursive(node->right, action);
-    }
-    
-    void preorderRecursive(Node* node, std::function<void(const T&)> action) const {
-        if (!node) return;
-        action(node->data);
-        preorderRecursive(node->left, action);
-        preorderRecursive(node->right, action);
-    }
-    
-    void postorderRecursive(Node* node, std::function<void(const T&)> action) const {
-        if (!node) return;
-        postorderRecursive(node->left, action);
-        postorderRecursive(node->right, action);
-        action(node->data);
-    }
-    
-    int heightRecursive(Node* node) const {
-        if (!node) return 0;
-        int leftHeight = heightRecursive(node->left);
-        int rightHeight = heightRecursive(node->right);
-        return 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    Node* findNode(const K& key) const {
+        Node* current = root;
+        while (current && !(current->key == key)) {
+            current = key < current->key ? current->left : current->right;
+        }
+        return current;
     }
     
-    void clearRecursive(Node* node) {
-        if (!node) return;
-        clearRecursive(node->left);
-        clearRecursive(node->right);
-        delete node;
+    // Rotate left children up until none remain, discarding each node on the
+    // way down the right spine: O(n) with no stack
+    void discardAll() {
+        Node* node = root;
+        while (node) {
+            if (node->left) {
+                Node* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                Node* right = node->right;
+                nodeAlloc.discard(node);
+                node = right;
+            }
+        }
     }
 };
 
@@ -720,7 +1778,7 @@ private:
 // ============================================================================
 // AVL TREE - Self-Balancing BST for Attendance Records by Date
 // ============================================================================
-template<typename T, typename K>
+template<typename T, typename K, template<typename> class NodeAllocator = NodePool>
 class AVLTree {
 public:
     struct Node {
@@ -729,52 +1787,253 @@ public:
         Node* left;
         Node* right;
         int height;
+        int size;  // Nodes in this subtree, for order-statistic queries
         
         Node(const T& value, const K& k) 
-            : data(value), key(k), left(nullptr), right(nullptr), height(1) {}
+            : data(value), key(k), left(nullptr), right(nullptr), height(1), size(1) {}
     };
 
 private:
+    // AVL height stays below 1.45 log2(n + 2), so 64 levels covers any
+    // int-sized tree and walks can use fixed path arrays
+    static const int MaxDepth = 64;
+    
     Node* root;
     int count;
     std::function<K(const T&)> keyExtractor;
+    NodeAllocator<Node> nodeAlloc;
+    mutable bool balanceKnown;  // isBalanced() result is valid until the next change
+    mutable bool balanced;
 
 public:
-    AVLTree(std::function<K(const T&)> extractor) : root(nullptr), count(0), keyExtractor(extractor) {}
+    // In-order (ascending key) iteration
+    using const_iterator = InorderIterator<Node, T>;
+    
+    const_iterator begin() const { return const_iterator(root); }
+    const_iterator end() const { return const_iterator(); }
+    
+    AVLTree(std::function<K(const T&)> extractor)
+        : root(nullptr), count(0), keyExtractor(extractor), balanceKnown(false), balanced(true) {}
     
     ~AVLTree() {
         clear();
     }
     
-    // Insert element with auto-balancing
+    // Insert element with auto-balancing: descend recording the links, then
+    // rebalance back up the path
     void insert(const T& value) {
         K key = keyExtractor(value);
-        root = insertRecursive(root, value, key);
+        Node** path[MaxDepth];
+        int depth = 0;
+        Node** link = &root;
+        while (*link) {
+            Node* node = *link;
+            if (key < node->key) {
+                path[depth++] = link;
+                link = &node->left;
+            } else if (key > node->key) {
+                path[depth++] = link;
+                link = &node->right;
+            } else {
+                // Duplicate key - update in place, shape is unchanged
+                node->data = value;
+                return;
+            }
+        }
+        
+        *link = nodeAlloc.create(value, key);
         count++;
+        balanceKnown = false;
+        rebalancePath(path, depth);
     }
     
     // Search by key
     T* search(const K& key) {
-        Node* result = searchRecursive(root, key);
+        Node* result = findNode(key);
         return result ? &(result->data) : nullptr;
     }
     
+    // Replace the contents with a perfectly balanced tree built from values
+    // without any rotations: O(n) for input already in key order,
+    // O(n log n) otherwise
+    void bulkLoad(const std::vector<T>& values) {
+        clear();
+        std::vector<std::pair<K, int>> order = bulkLoadOrder<K>(values, keyExtractor);
+        root = buildBalanced(values, order, 0, static_cast<int>(order.size()) - 1);
+        count = static_cast<int>(order.size());
+    }
+    
+    // Merge a batch into the tree: the batch is built into a balanced tree,
+    // then combined by split/join in O(m log(n/m + 1)) for m values and n
+    // keys, instead of m separate insert-and-rebalance passes. Equal keys
+    // take the batch's value (the last one within the batch), as insert() does.
+    void unionWith(const std::vector<T>& values) {
+        if (values.empty()) return;
+        std::vector<std::pair<K, int>> order = bulkLoadOrder<K>(values, keyExtractor);
+        Node* batch = buildBalanced(values, order, 0, static_cast<int>(order.size()) - 1);
+        root = unite(root, batch);
+        count = getNodeSize(root);
+        balanceKnown = false;
+    }
+    
+    // Remove every key in [low, high] with two splits and a join: O(log n),
+    // plus O(m) to free the m removed nodes. Returns m.
+    int eraseRange(const K& low, const K& high) {
+        if (high < low || !root) return 0;
+        Node *below, *rest, *inside, *above;
+        Node* atLow = split(root, low, below, rest);
+        Node* atHigh = split(rest, high, inside, above);
+        
+        int removed = getNodeSize(inside);
+        destroySubtree(inside);
+        if (atLow) {
+            nodeAlloc.destroy(atLow);
+            removed++;
+        }
+        if (atHigh) {
+            nodeAlloc.destroy(atHigh);
+            removed++;
+        }
+        
+        root = join(below, above);
+        count -= removed;
+        if (removed > 0) balanceKnown = false;
+        return removed;
+    }
+    
     // Delete by key with auto-balancing
     bool remove(const K& key) {
-        if (!search(key)) return false;
-        root = deleteRecursive(root, key);
+        Node** path[MaxDepth];
+        int depth = 0;
+        Node** link = &root;
+        while (*link) {
+            Node* node = *link;
+            if (key < node->key) {
+                path[depth++] = link;
+                link = &node->left;
+            } else if (key > node->key) {
+                path[depth++] = link;
+                link = &node->right;
+            } else {
+                break;
+            }
+        }
+        
+        Node* node = *link;
+        if (!node) return false;
+        
+        if (node->left && node->right) {
+            // Two children: take over the in-order successor's entry and
+            // unlink the successor, which has no left child
+            path[depth++] = link;
+            Node** successorLink = &node->right;
+            while ((*successorLink)->left) {
+                path[depth++] = successorLink;
+                successorLink = &(*successorLink)->left;
+            }
+            Node* successor = *successorLink;
+            node->key = successor->key;
+            node->data = successor->data;
+            link = successorLink;
+            node = successor;
+        }
+        
+        *link = node->left ? node->left : node->right;
+        nodeAlloc.destroy(node);
         count--;
+        balanceKnown = false;
+        rebalancePath(path, depth);
+        return true;
+    }
+    
+    // Update element (key must not change)
+    bool update(const K& key, const T& newValue) {
+        T* existing = search(key);
+        if (existing) {
+            *existing = newValue;
+            return true;
+        }
+        return false;
+    }
+    
+    // Range search (useful for date ranges); returns false if stopped early
+    template<typename Visitor>
+    bool rangeSearch(const K& low, const K& high, Visitor&& visitor) const {
+        // In-order walk that never descends into subtrees left of low
+        Node* stack[MaxDepth];
+        int top = 0;
+        Node* node = root;
+        while (node || top > 0) {
+            while (node) {
+                if (node->key < low) {
+                    node = node->right;
+                } else {
+                    stack[top++] = node;
+                    node = node->left;
+                }
+            }
+            if (top == 0) return true;
+            node = stack[--top];
+            if (high < node->key) return true;
+            if (!visitAndContinue(visitor, node->data)) return false;
+            node = node->right;
+        }
         return true;
     }
     
-    // Range search (useful for date ranges)
     void rangeSearch(const K& low, const K& high, std::function<void(const T&)> action) const {
-        rangeSearchRecursive(root, low, high, action);
+        rangeSearch<std::function<void(const T&)>&>(low, high, action);
+    }
+    
+    // In-order traversal (sorted by key); returns false if stopped early
+    template<typename Visitor>
+    bool inorderTraversal(Visitor&& visitor) const {
+        Node* stack[MaxDepth];
+        int top = 0;
+        Node* node = root;
+        while (node || top > 0) {
+            while (node) {
+                stack[top++] = node;
+                node = node->left;
+            }
+            node = stack[--top];
+            if (!visitAndContinue(visitor, node->data)) return false;
+            node = node->right;
+        }
+        return true;
     }
     
-    // In-order traversal (sorted by key)
     void inorderTraversal(std::function<void(const T&)> action) const {
-        inorderRecursive(root, action);
+        inorderTraversal<std::function<void(const T&)>&>(action);
+    }
+    
+    // Number of keys in [low, high] without visiting them: O(log n)
+    int countInRange(const K& low, const K& high) const {
+        if (high < low) return 0;
+        return countBelow(high, true) - countBelow(low, false);
+    }
+    
+    // Number of keys strictly less than the given key: O(log n)
+    int rank(const K& key) const {
+        return countBelow(key, false);
+    }
+    
+    // Element at the given 0-based position in key order, or nullptr: O(log n)
+    T* select(int index) {
+        if (index < 0 || index >= count) return nullptr;
+        Node* current = root;
+        while (current) {
+            int leftSize = getNodeSize(current->left);
+            if (index < leftSize) {
+                current = current->left;
+            } else if (index == leftSize) {
+                return &(current->data);
+            } else {
+                index -= leftSize + 1;
+                current = current->right;
+            }
+        }
+        return nullptr;
     }
     
     // Get size
@@ -788,16 +2047,24 @@ public:
         return root ? root->height : 0;
     }
     
-    // Check if balanced
+    // Check if balanced: O(n) verification, cached until the tree changes
     bool isBalanced() const {
-        return isBalancedRecursive(root);
+        if (!balanceKnown) {
+            balanced = verifyBalance();
+            balanceKnown = true;
+        }
+        return balanced;
     }
     
     // Clear tree
     void clear() {
-        clearRecursive(root);
+        if (NodeAllocator<Node>::needsNodeWalk) {
+            discardAll();
+        }
+        nodeAlloc.releaseAll();
         root = nullptr;
         count = 0;
+        balanceKnown = false;
     }
     
     // Convert to QList
@@ -809,8 +2076,24 @@ public:
         return list;
     }
     
+    // Find the element with the largest key <= given key
+    T* findFloor(const K& key) {
+        Node* current = root;
+        Node* best = nullptr;
+        while (current) {
+            if (current->key <= key) {
+                best = current;
+                current = current->right;
+            } else {
+                current = current->left;
+            }
+        }
+        return best ? &(best->data) : nullptr;
+    }
+    
     // Find all matching a condition
-    QList<T> findAll(std::function<bool(const T&)> condition) const {
+    template<typename Predicate>
+    QList<T> findAll(Predicate&& condition) const {
         QList<T> results;
         inorderTraversal([&results, &condition](const T& item) {
             if (condition(item)) {
@@ -819,22 +2102,47 @@ public:
         });
         return results;
     }
+    
+    QList<T> findAll(std::function<bool(const T&)> condition) const {
+        return findAll<std::function<bool(const T&)>&>(condition);
+    }
 
 private:
     int getNodeHeight(Node* node) const {
         return node ? node->height : 0;
     }
     
+    int getNodeSize(Node* node) const {
+        return node ? node->size : 0;
+    }
+    
     int getBalance(Node* node) const {
         return node ? getNodeHeight(node->left) - getNodeHeight(node->right) : 0;
     }
     
+    // Refresh cached height and subtree size from the children
     void updateHeight(Node* node) {
         if (node) {
             int leftHeight = getNodeHeight(node->left);
             int rightHeight = getNodeHeight(node->right);
             node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+            node->size = 1 + getNodeSize(node->left) + getNodeSize(node->right);
+        }
+    }
+    
+    // Keys < key (or <= key when inclusive), summing left subtree sizes on the way down
+    int countBelow(const K& key, bool inclusive) const {
+        int result = 0;
+        Node* current = root;
+        while (current) {
+            if (current->key < key || (inclusive && current->key == key)) {
+                result += getNodeSize(current->left) + 1;
+                current = current->right;
+            } else {
+                current = current->left;
+            }
         }
+        return result;
     }
     
     // Right rotation
@@ -865,288 +2173,2543 @@ private:
         return y;
     }
     
-    Node* insertRecursive(Node* node, const T& value, const K& key) {
-        // Standard BST insert
-        if (!node) {
-            return new Node(value, key);
-        }
-        
-        if (key < node->key) {
-            node->left = insertRecursive(node->left, value, key);
-        } else if (key > node->key) {
-            node->right = insertRecursive(node->right, value, key);
-        } else {
-            // Duplicate key - update or add to list
-            node->data = value;
-            count--;
-            return node;
+    // Middle element becomes the root, so sibling heights differ by at most
+    // one; nodes are allocated in key order for sequential in-order walks
+    Node* buildBalanced(const std::vector<T>& values, const std::vector<std::pair<K, int>>& order,
+                        int low, int high) {
+        if (low > high) return nullptr;
+        int mid = low + (high - low) / 2;
+        Node* left = buildBalanced(values, order, low, mid - 1);
+        Node* node = nodeAlloc.create(values[order[mid].second], order[mid].first);
+        node->left = left;
+        node->right = buildBalanced(values, order, mid + 1, high);
+        updateHeight(node);
+        return node;
+    }
+    
+    Node* findNode(const K& key) const {
+        Node* current = root;
+        while (current && !(current->key == key)) {
+            current = key < current->key ? current->left : current->right;
         }
-        
-        // Update height
+        return current;
+    }
+    
+    // Restore height, size and balance of one subtree after a change below it
+    Node* rebalance(Node* node) {
         updateHeight(node);
-        
-        // Get balance factor
         int balance = getBalance(node);
         
-        // Left Left Case
-        if (balance > 1 && key < node->left->key) {
-            return rightRotate(node);
-        }
-        
-        // Right Right Case
-        if (balance < -1 && key > node->right->key) {
-            return leftRotate(node);
-        }
-        
-        // Left Right Case
-        if (balance > 1 && key > node->left->key) {
-            node->left = leftRotate(node->left);
+        if (balance > 1) {
+            // Left Right Case needs the extra rotation; Left Left does not
+            if (getBalance(node->left) < 0) {
+                node->left = leftRotate(node->left);
+            }
             return rightRotate(node);
         }
         
-        // Right Left Case
-        if (balance < -1 && key < node->right->key) {
-            node->right = rightRotate(node->right);
+        if (balance < -1) {
+            // Right Left Case needs the extra rotation; Right Right does not
+            if (getBalance(node->right) > 0) {
+                node->right = rightRotate(node->right);
+            }
             return leftRotate(node);
         }
         
         return node;
     }
     
-    Node* searchRecursive(Node* node, const K& key) const {
-        if (!node || node->key == key) {
-            return node;
+    // Walk the recorded links bottom-up. Every ancestor's subtree size changed,
+    // so the walk always reaches the root.
+    void rebalancePath(Node** path[], int depth) {
+        while (depth > 0) {
+            Node** link = path[--depth];
+            *link = rebalance(*link);
         }
-        
-        if (key < node->key) {
-            return searchRecursive(node->left, key);
+    }
+    
+    // Split/join primitives on detached subtrees. Each recursion follows one
+    // root-to-leaf path, so the depth stays within the tree height.
+    
+    // Join left < pivot < right into one balanced subtree in
+    // O(|h(left) - h(right)|): pivot is hung on the taller side's spine at
+    // the shorter side's height, then the spine is rebalanced back up
+    Node* join(Node* left, Node* pivot, Node* right) {
+        int leftHeight = getNodeHeight(left);
+        int rightHeight = getNodeHeight(right);
+        if (leftHeight > rightHeight + 1) {
+            left->right = join(left->right, pivot, right);
+            return rebalance(left);
         }
-        return searchRecursive(node->right, key);
+        if (rightHeight > leftHeight + 1) {
+            right->left = join(left, pivot, right->left);
+            return rebalance(right);
+        }
+        pivot->left = left;
+        pivot->right = right;
+        updateHeight(pivot);
+        return pivot;
     }
     
-    Node* getMinNode(Node* node) const {
-        Node* current = node;
-        while (current && current->left) {
-            current = current->left;
+    // Join left < right without a pivot: right's minimum is detached to serve as one
+    Node* join(Node* left, Node* right) {
+        if (!left) return right;
+        if (!right) return left;
+        Node* minimum;
+        right = detachMin(right, minimum);
+        return join(left, minimum, right);
+    }
+    
+    Node* detachMin(Node* node, Node*& minimum) {
+        if (!node->left) {
+            minimum = node;
+            return node->right;
         }
-        return current;
+        node->left = detachMin(node->left, minimum);
+        return rebalance(node);
     }
     
-    Node* deleteRecursive(Node* node, const K& key) {
-        if (!node) return nullptr;
-        
+    // Split a subtree into keys < key (less) and keys > key (greater).
+    // Returns the detached node holding key, or nullptr if there is none.
+    Node* split(Node* node, const K& key, Node*& less, Node*& greater) {
+        if (!node) {
+            less = greater = nullptr;
+            return nullptr;
+        }
+        Node* left = node->left;
+        Node* right = node->right;
+        Node* match;
         if (key < node->key) {
-            node->left = deleteRecursive(node->left, key);
-        } else if (key > node->key) {
-            node->right = deleteRecursive(node->right, key);
+            match = split(left, key, less, left);
+            greater = join(left, node, right);
+        } else if (node->key < key) {
+            match = split(right, key, right, greater);
+            less = join(left, node, right);
         } else {
-            // Node to delete found
-            if (!node->left || !node->right) {
-                Node* temp = node->left ? node->left : node->right;
-                
-                if (!temp) {
-                    temp = node;
-                    node = nullptr;
-                } else {
-                    *node = *temp;
-                }
-                delete temp;
-            } else {
-                Node* temp = getMinNode(node->right);
-                node->key = temp->key;
-                node->data = temp->data;
-                node->right = deleteRecursive(node->right, temp->key);
-            }
-        }
-        
-        if (!node) return nullptr;
-        
-        // Update height
-        updateHeight(node);
-        
-        // Balance the tree
-        int balance = getBalance(node);
-        
-        // Left Left Case
-        if (balance > 1 && getBalance(node->left) >= 0) {
-            return rightRotate(node);
-        }
-        
-        // Left Right Case
-        if (balance > 1 && getBalance(node->left) < 0) {
-            node->left = leftRotate(node->left);
-            return rightRotate(node);
-        }
-        
-        // Right Right Case
-        if (balance < -1 && getBalance(node->right) <= 0) {
-            return leftRotate(node);
-        }
-        
-        // Right Left Case
-        if (balance < -1 && getBalance(node->right) > 0) {
-            node->right = rightRotate(node->right);
-            return leftRotate(node);
+            less = left;
+            greater = right;
+            match = node;
         }
-        
-        return node;
+        return match;
     }
     
-    void rangeSearchRecursive(Node* node, const K& low, const K& high, 
-                              std::function<void(const T&)> action) const {
-        if (!node) return;
-        
-        if (low < node->key) {
-            rangeSearchRecursive(node->left, low, high, action);
-        }
-        
-        if (low <= node->key && node->key <= high) {
-            action(node->data);
-        }
-        
-        if (high > node->key) {
-            rangeSearchRecursive(node->right, low, high, action);
+    // Union of two subtrees: split a around b's root and recurse on each
+    // side. On equal keys b's node is kept and a's is freed.
+    Node* unite(Node* a, Node* b) {
+        if (!a) return b;
+        if (!b) return a;
+        Node* less;
+        Node* greater;
+        Node* duplicate = split(a, b->key, less, greater);
+        if (duplicate) {
+            nodeAlloc.destroy(duplicate);
         }
+        Node* left = unite(less, b->left);
+        Node* right = unite(greater, b->right);
+        return join(left, b, right);
     }
     
-    void inorderRecursive(Node* node, std::function<void(const T&)> action) const {
-        if (!node) return;
-        inorderRecursive(node->left, action);
-        action(node->data);
-        inorderRecursive(node->right, action);
+    // Local check per node (stored height and balance factor), so any visit
+    // order works; uses a heap stack since a broken tree may be arbitrarily deep
+    bool verifyBalance() const {
+        std::vector<Node*> stack;
+        if (root) stack.push_back(root);
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            int leftHeight = getNodeHeight(node->left);
+            int rightHeight = getNodeHeight(node->right);
+            if (node->height != 1 + std::max(leftHeight, rightHeight)) return false;
+            if (leftHeight - rightHeight < -1 || leftHeight - rightHeight > 1) return false;
+            if (node->left) stack.push_back(node->left);
+            if (node->right) stack.push_back(node->right);
+        }
+        return true;
     }
     
-    bool isBalancedRecursive(Node* node) const {
-        if (!node) return true;
-        
-        int balance = getBalance(node);
-        if (balance < -1 || balance > 1) return false;
-        
-        return isBalancedRecursive(node->left) && isBalancedRecursive(node->right);
+    // Rotate left children up until none remain, discarding each node on the
+    // way down the right spine: O(n) with no stack
+    void discardAll() {
+        Node* node = root;
+        while (node) {
+            if (node->left) {
+                Node* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                Node* right = node->right;
+                nodeAlloc.discard(node);
+                node = right;
+            }
+        }
     }
     
-    void clearRecursive(Node* node) {
-        if (!node) return;
-        clearRecursive(node->left);
-        clearRecursive(node->right);
-        delete node;
+    // Same walk for a detached subtree whose slots go back to the free list
+    void destroySubtree(Node* node) {
+        while (node) {
+            if (node->left) {
+                Node* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                Node* right = node->right;
+                nodeAlloc.destroy(node);
+                node = right;
+            }
+        }
     }
 };
 
 
 // ============================================================================
-// ACTION RECORD - For Undo/Redo Stack
+// INTERVAL TREE - Augmented AVL Tree for Date-Range Queries on Leave
 // ============================================================================
-enum class ActionType {
-    ADD_EMPLOYEE,
-    EDIT_EMPLOYEE,
-    DELETE_EMPLOYEE,
-    APPROVE_LEAVE,
-    REJECT_LEAVE
-};
+// Closed intervals [low, high] ordered by (low, id). Every node also stores the
+// largest high endpoint in its subtree, so queries skip subtrees that end
+// before the range of interest: O(log n + k) for k results in practice.
+template<typename T, typename P = qint64, template<typename> class NodeAllocator = NodePool>
+class IntervalTree {
+public:
+    struct Node {
+        T data;
+        P low;
+        P high;
+        quint64 id;         // Tells apart intervals with the same low endpoint
+        P maxHigh;          // Largest high endpoint in this subtree
+        Node* left;
+        Node* right;
+        int height;
+        
+        Node(const T& value, const P& lo, const P& hi, quint64 i)
+            : data(value), low(lo), high(hi), id(i), maxHigh(hi),
+              left(nullptr), right(nullptr), height(1) {}
+    };
 
-struct ActionRecord {
-    ActionType type;
-    Employee employee;          // For employee actions
-    Employee previousEmployee;  // For edit operations (to restore)
-    LeaveRequest leaveRequest; // For leave actions
-    LeaveStatus previousStatus; // For leave status changes
+private:
+    // Same bound as AVLTree: fixed path arrays cover any int-sized tree
+    static const int MaxDepth = 64;
     
-    ActionRecord() : type(ActionType::ADD_EMPLOYEE), previousStatus(LeaveStatus::Pending) {}
-};
-
+    Node* root;
+    int count;
+    NodeAllocator<Node> nodeAlloc;
 
-// ============================================================================
-// DATA MANAGER - Central Data Management with DSA
-// ============================================================================
-class DataManager {
-private:
-    // Doubly Linked List for Employee Management
-    DoublyLinkedList<Employee> m_employeeList;
+public:
+    IntervalTree() : root(nullptr), count(0) {}
     
-    // BST for fast employee search by ID
-    BST<Employee, int>* m_employeeBST;
+    ~IntervalTree() {
+        clear();
+    }
     
-    // Queue for Leave Request Processing
-    Queue<LeaveRequest> m_pendingLeaveQueue;
+    IntervalTree(const IntervalTree&) = delete;
+    IntervalTree& operator=(const IntervalTree&) = delete;
     
-    // Doubly Linked List for all leave requests
-    DoublyLinkedList<LeaveRequest> m_allLeaveRequests;
+    // Insert [low, high]; an interval with the same (low, id) is replaced.
+    // Descend recording the links, then rebalance back up the path.
+    void insert(const P& low, const P& high, quint64 id, const T& value) {
+        Node** path[MaxDepth];
+        int depth = 0;
+        Node** link = &root;
+        while (*link) {
+            Node* node = *link;
+            path[depth++] = link;
+            if (less(low, id, node->low, node->id)) {
+                link = &node->left;
+            } else if (less(node->low, node->id, low, id)) {
+                link = &node->right;
+            } else {
+                // Same interval - shape is unchanged, but maxHigh may change
+                // on the path up to the root
+                node->high = high;
+                node->data = value;
+                rebalancePath(path, depth);
+                return;
+            }
+        }
+        
+        *link = nodeAlloc.create(value, low, high, id);
+        count++;
+        rebalancePath(path, depth);
+    }
+    
+    // Remove the interval identified by (low, id)
+    bool remove(const P& low, quint64 id) {
+        Node** path[MaxDepth];
+        int depth = 0;
+        Node** link = &root;
+        while (*link) {
+            Node* node = *link;
+            if (less(low, id, node->low, node->id)) {
+                path[depth++] = link;
+                link = &node->left;
+            } else if (less(node->low, node->id, low, id)) {
+                path[depth++] = link;
+                link = &node->right;
+            } else {
+                break;
+            }
+        }
+        
+        Node* node = *link;
+        if (!node) return false;
+        
+        if (node->left && node->right) {
+            // Two children: take over the in-order successor's interval and
+            // unlink the successor, which has no left child
+            path[depth++] = link;
+            Node** successorLink = &node->right;
+            while ((*successorLink)->left) {
+                path[depth++] = successorLink;
+                successorLink = &(*successorLink)->left;
+            }
+            Node* successor = *successorLink;
+            node->data = successor->data;
+            node->low = successor->low;
+            node->high = successor->high;
+            node->id = successor->id;
+            link = successorLink;
+            node = successor;
+        }
+        
+        *link = node->left ? node->left : node->right;
+        nodeAlloc.destroy(node);
+        count--;
+        rebalancePath(path, depth);
+        return true;
+    }
     
-    // AVL Tree for Attendance Records (by date)
-    AVLTree<AttendanceRecord, QString>* m_attendanceAVL;  // Key: date_employeeId
+    // Stabbing query: every interval containing point
+    template<typename Visitor>
+    bool stab(const P& point, Visitor&& visitor) const {
+        return overlapWalk(point, point, visitor);
+    }
     
-    // Stack for Undo operations
-    Stack<ActionRecord> m_undoStack;
+    // Every interval intersecting [low, high]; returns false if stopped early
+    template<typename Visitor>
+    bool overlapping(const P& low, const P& high, Visitor&& visitor) const {
+        return overlapWalk(low, high, visitor);
+    }
     
-    // Stack for Redo operations
-    Stack<ActionRecord> m_redoStack;
+    // True if any interval intersects [low, high]; stops at the first match
+    bool overlapsAny(const P& low, const P& high) const {
+        return !overlapping(low, high, [](const T&) { return false; });
+    }
     
-    static DataManager* instance;
+    // Get size
+    int size() const { return count; }
     
-    DataManager() {
-        m_employeeBST = new BST<Employee, int>([](const Employee& e) { return e.getId(); });
-        m_attendanceAVL = new AVLTree<AttendanceRecord, QString>([](const AttendanceRecord& r) {
-            return r.getDate().toString("yyyy-MM-dd") + "_" + QString::number(r.getEmployeeId());
-        });
+    // Check if empty
+    bool isEmpty() const { return count == 0; }
+    
+    // Get tree height
+    int getHeight() const { return nodeHeight(root); }
+    
+    // Clear tree
+    void clear() {
+        if (NodeAllocator<Node>::needsNodeWalk) {
+            discardAll();
+        }
+        nodeAlloc.releaseAll();
+        root = nullptr;
+        count = 0;
     }
 
-public:
-    static DataManager* getInstance() {
-        if (!instance) {
-            instance = new DataManager();
-        }
-        return instance;
+private:
+    static bool less(const P& lowA, quint64 idA, const P& lowB, quint64 idB) {
+        return lowA < lowB || (lowA == lowB && idA < idB);
     }
     
-    ~DataManager() {
-        delete m_employeeBST;
-        delete m_attendanceAVL;
+    static int nodeHeight(Node* node) {
+        return node ? node->height : 0;
     }
     
-    // Employee Operations using Doubly Linked List + BST
-    void addEmployee(const Employee& emp, bool recordAction = true);
-    bool updateEmployee(int id, const Employee& emp, bool recordAction = true);
-    bool deleteEmployee(int id, bool recordAction = true);
-    Employee* findEmployee(int id);
-    QList<Employee> getAllEmployees();
-    int getEmployeeCount();
+    // Recompute height and maxHigh from the children
+    static void refresh(Node* node) {
+        node->height = 1 + std::max(nodeHeight(node->left), nodeHeight(node->right));
+        node->maxHigh = node->high;
+        if (node->left && node->maxHigh < node->left->maxHigh) node->maxHigh = node->left->maxHigh;
+        if (node->right && node->maxHigh < node->right->maxHigh) node->maxHigh = node->right->maxHigh;
+    }
     
-    // Leave Request Operations using Queue
-    void submitLeaveRequest(const LeaveRequest& request);
-    LeaveRequest* getNextPendingRequest();
-    bool processLeaveRequest(int employeeId, const QDate& startDate, LeaveStatus newStatus, bool recordAction = true);
-    QList<LeaveRequest> getAllLeaveRequests();
-    QList<LeaveRequest> getPendingRequests();
-    QList<LeaveRequest> getEmployeeLeaveRequests(int employeeId);
+    static Node* rotateRight(Node* y) {
+        Node* x = y->left;
+        y->left = x->right;
+        x->right = y;
+        refresh(y);
+        refresh(x);
+        return x;
+    }
     
-    // Attendance Operations using AVL Tree
-    void addAttendanceRecord(const AttendanceRecord& record);
-    AttendanceRecord* findAttendanceRecord(int employeeId, const QDate& date);
-    QList<AttendanceRecord> getAttendanceByDateRange(const QDate& start, const QDate& end);
-    QList<AttendanceRecord> getEmployeeAttendance(int employeeId);
-    bool hasAttendanceToday(int employeeId);
+    static Node* rotateLeft(Node* x) {
+        Node* y = x->right;
+        x->right = y->left;
+        y->left = x;
+        refresh(x);
+        refresh(y);
+        return y;
+    }
+    
+    static Node* rebalance(Node* node) {
+        refresh(node);
+        int balance = nodeHeight(node->left) - nodeHeight(node->right);
+        
+        if (balance > 1) {
+            if (nodeHeight(node->left->left) < nodeHeight(node->left->right)) {
+                node->left = rotateLeft(node->left);
+            }
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (nodeHeight(node->right->right) < nodeHeight(node->right->left)) {
+                node->right = rotateRight(node->right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+    
+    // Walk the recorded links bottom-up, refreshing height and maxHigh of
+    // every ancestor
+    void rebalancePath(Node** path[], int depth) {
+        while (depth > 0) {
+            Node** link = path[--depth];
+            *link = rebalance(*link);
+        }
+    }
+    
+    // In-order walk that skips subtrees ending before low and stops at the
+    // first node starting after high
+    template<typename Visitor>
+    bool overlapWalk(const P& low, const P& high, Visitor& visitor) const {
+        Node* stack[MaxDepth];
+        int top = 0;
+        Node* node = root;
+        while (true) {
+            // Nothing in a subtree with maxHigh < low ends at or after low
+            while (node && !(node->maxHigh < low)) {
+                stack[top++] = node;
+                node = node->left;
+            }
+            if (top == 0) return true;
+            node = stack[--top];
+            
+            // Everything after this node starts after it, so also after high
+            if (high < node->low) return true;
+            if (!(node->high < low)) {
+                if (!visitAndContinue(visitor, node->data)) return false;
+            }
+            node = node->right;
+        }
+    }
+    
+    // Rotate left children up until none remain, discarding each node on the
+    // way down the right spine: O(n) with no stack
+    void discardAll() {
+        Node* node = root;
+        while (node) {
+            if (node->left) {
+                Node* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                Node* right = node->right;
+                nodeAlloc.discard(node);
+                node = right;
+            }
+        }
+    }
+};
+
+
+// ============================================================================
+// B+ TREE - Cache-Friendly Store for Attendance Records by Date
+// ============================================================================
+// Keys and values live in wide, contiguous leaf pages and leaves are linked,
+// so range scans walk pages sequentially instead of chasing a pointer per
+// record. T must be default-constructible (leaf pages are preallocated).
+template<typename T, typename K, int LeafCapacity = 64, int InnerCapacity = 64>
+class BPlusTree {
+    static_assert(LeafCapacity >= 4 && InnerCapacity >= 4, "B+ tree pages need at least 4 slots");
+
+public:
+    struct NodeBase {
+        bool isLeaf;
+        int count;      // Number of keys in this page
+        
+        NodeBase(bool leaf) : isLeaf(leaf), count(0) {}
+    };
+    
+    struct LeafNode : NodeBase {
+        K keys[LeafCapacity];
+        T values[LeafCapacity];
+        LeafNode* prev;
+        LeafNode* next;
+        
+        LeafNode() : NodeBase(true), prev(nullptr), next(nullptr) {}
+    };
+    
+    struct InnerNode : NodeBase {
+        K keys[InnerCapacity];                  // keys[i] = smallest key under children[i + 1]
+        NodeBase* children[InnerCapacity + 1];
+        
+        InnerNode() : NodeBase(false) {}
+    };
+
+private:
+    struct PathEntry {
+        InnerNode* node;
+        int childIndex;
+    };
+    
+    // Pages are at least half full, so 32 levels is far beyond any real size
+    static const int MaxDepth = 32;
+    
+    NodeBase* root;
+    LeafNode* firstLeaf;
+    int count;
+    int height;
+    std::function<K(const T&)> keyExtractor;
+
+public:
+    // Forward iterator along the leaf chain (ascending key)
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+        
+        const_iterator() : leaf(nullptr), pos(0) {}
+        const_iterator(const LeafNode* l, int p) : leaf(l), pos(p) { skipExhausted(); }
+        
+        reference operator*() const { return leaf->values[pos]; }
+        pointer operator->() const { return &(leaf->values[pos]); }
+        const K& key() const { return leaf->keys[pos]; }
+        
+        const_iterator& operator++() {
+            pos++;
+            skipExhausted();
+            return *this;
+        }
+        
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++(*this);
+            return old;
+        }
+        
+        bool operator==(const const_iterator& other) const {
+            return leaf == other.leaf && pos == other.pos;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    
+    private:
+        void skipExhausted() {
+            while (leaf && pos >= leaf->count) {
+                leaf = leaf->next;
+                pos = 0;
+            }
+        }
+        
+        const LeafNode* leaf;
+        int pos;
+    };
+    
+    const_iterator begin() const { return const_iterator(firstLeaf, 0); }
+    const_iterator end() const { return const_iterator(); }
+    
+    BPlusTree(std::function<K(const T&)> extractor)
+        : root(nullptr), firstLeaf(nullptr), count(0), height(0), keyExtractor(extractor) {}
+    
+    ~BPlusTree() {
+        clear();
+    }
+    
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+    
+    // Insert element (existing key is updated in place)
+    void insert(const T& value) {
+        K key = keyExtractor(value);
+        
+        if (!root) {
+            LeafNode* leaf = new LeafNode();
+            leaf->keys[0] = key;
+            leaf->values[0] = value;
+            leaf->count = 1;
+            root = firstLeaf = leaf;
+            height = 1;
+            count = 1;
+            return;
+        }
+        
+        PathEntry path[MaxDepth];
+        int depth = 0;
+        LeafNode* leaf = findLeaf(key, path, depth);
+        int pos = lowerBoundIndex(leaf->keys, leaf->count, key);
+        
+        if (pos < leaf->count && !(key < leaf->keys[pos])) {
+            // Duplicate key - update
+            leaf->values[pos] = value;
+            return;
+        }
+        
+        count++;
+        if (leaf->count < LeafCapacity) {
+            insertIntoLeaf(leaf, pos, key, value);
+            return;
+        }
+        
+        // Leaf is full - split it in half and link the new page
+        LeafNode* right = new LeafNode();
+        int mid = LeafCapacity / 2;
+        for (int i = mid; i < LeafCapacity; i++) {
+            right->keys[i - mid] = std::move(leaf->keys[i]);
+            right->values[i - mid] = std::move(leaf->values[i]);
+        }
+        right->count = LeafCapacity - mid;
+        leaf->count = mid;
+        
+        right->next = leaf->next;
+        if (right->next) {
+            right->next->prev = right;
+        }
+        right->prev = leaf;
+        leaf->next = right;
+        
+        if (pos <= mid) {
+            insertIntoLeaf(leaf, pos, key, value);
+        } else {
+            insertIntoLeaf(right, pos - mid, key, value);
+        }
+        
+        insertIntoParent(path, depth, right->keys[0], right);
+    }
+    
+    // Replace the contents by packing pages bottom-up instead of splitting:
+    // O(n) for input already in key order, O(n log n) otherwise. Entries are
+    // spread evenly over the fewest pages, so every page is at least half full.
+    void bulkLoad(const std::vector<T>& values) {
+        clear();
+        std::vector<std::pair<K, int>> order = bulkLoadOrder<K>(values, keyExtractor);
+        int n = static_cast<int>(order.size());
+        if (n == 0) return;
+        
+        // Leaf level, linked left to right
+        std::vector<NodeBase*> level;
+        std::vector<K> lowKeys;     // Smallest key under each page of the level
+        int pages = (n + LeafCapacity - 1) / LeafCapacity;
+        LeafNode* previous = nullptr;
+        for (int page = 0, next = 0; page < pages; page++) {
+            int take = n / pages + (page < n % pages ? 1 : 0);
+            LeafNode* leaf = new LeafNode();
+            for (int i = 0; i < take; i++, next++) {
+                leaf->keys[i] = order[next].first;
+                leaf->values[i] = values[order[next].second];
+            }
+            leaf->count = take;
+            leaf->prev = previous;
+            if (previous) {
+                previous->next = leaf;
+            } else {
+                firstLeaf = leaf;
+            }
+            previous = leaf;
+            level.push_back(leaf);
+            lowKeys.push_back(leaf->keys[0]);
+        }
+        height = 1;
+        
+        // Inner levels until a single root remains
+        while (level.size() > 1) {
+            int children = static_cast<int>(level.size());
+            int parents = (children + InnerCapacity) / (InnerCapacity + 1);
+            std::vector<NodeBase*> upper;
+            std::vector<K> upperKeys;
+            for (int page = 0, next = 0; page < parents; page++) {
+                int take = children / parents + (page < children % parents ? 1 : 0);
+                InnerNode* inner = new InnerNode();
+                upperKeys.push_back(lowKeys[next]);
+                for (int i = 0; i < take; i++, next++) {
+                    inner->children[i] = level[next];
+                    if (i > 0) {
+                        inner->keys[i - 1] = lowKeys[next];
+                    }
+                }
+                inner->count = take - 1;
+                upper.push_back(inner);
+            }
+            level.swap(upper);
+            lowKeys.swap(upperKeys);
+            height++;
+        }
+        
+        root = level[0];
+        count = n;
+    }
+    
+    // Search by key
+    T* search(const K& key) {
+        if (!root) return nullptr;
+        
+        LeafNode* leaf = findLeaf(key);
+        int pos = lowerBoundIndex(leaf->keys, leaf->count, key);
+        if (pos < leaf->count && !(key < leaf->keys[pos])) {
+            return &(leaf->values[pos]);
+        }
+        return nullptr;
+    }
+    
+    // Delete by key, borrowing from or merging with sibling pages on underflow
+    bool remove(const K& key) {
+        if (!root) return false;
+        
+        PathEntry path[MaxDepth];
+        int depth = 0;
+        LeafNode* leaf = findLeaf(key, path, depth);
+        int pos = lowerBoundIndex(leaf->keys, leaf->count, key);
+        if (pos >= leaf->count || key < leaf->keys[pos]) {
+            return false;
+        }
+        
+        eraseFromLeaf(leaf, pos);
+        count--;
+        rebalanceLeaf(leaf, path, depth);
+        return true;
+    }
+    
+    // Remove every key in [low, high]. Pages wholly inside the range are
+    // unlinked from the leaf chain and freed without touching their keys;
+    // only the pages along the two edges of the range are merged or
+    // refilled: O(log^2 n) page operations plus O(m / LeafCapacity) pages
+    // freed for m removed keys. Returns m.
+    int eraseRange(const K& low, const K& high) {
+        if (!root || high < low) return 0;
+        
+        int removed = eraseBelow(root, low, high);
+        count -= removed;
+        
+        // The root may be left with a single child (or an empty leaf)
+        while (!root->isLeaf && root->count == 0) {
+            InnerNode* inner = static_cast<InnerNode*>(root);
+            root = inner->children[0];
+            delete inner;
+            height--;
+        }
+        if (root->count == 0) {
+            delete static_cast<LeafNode*>(root);
+            root = nullptr;
+            firstLeaf = nullptr;
+            height = 0;
+        }
+        return removed;
+    }
+    
+    // Merge a batch into the tree in key order. Each leaf takes the batch
+    // keys that belong in it in one merge pass (splitting off at most one
+    // new page per pass), so a descent is paid per page touched rather than
+    // per key: O(m log m) to order the batch, then O(m + p log n) for m
+    // values landing in p pages. Equal keys take the batch's value (the
+    // last one within the batch), as insert() does.
+    void unionWith(const std::vector<T>& values) {
+        if (!root) {
+            bulkLoad(values);
+            return;
+        }
+        std::vector<std::pair<K, int>> order = bulkLoadOrder<K>(values, keyExtractor);
+        
+        size_t next = 0;
+        while (next < order.size()) {
+            PathEntry path[MaxDepth];
+            int depth = 0;
+            LeafNode* leaf = findLeaf(order[next].first, path, depth);
+            
+            // The deepest separator to the right bounds this leaf's keys
+            size_t end = order.size();
+            for (int i = depth - 1; i >= 0; i--) {
+                if (path[i].childIndex < path[i].node->count) {
+                    const K& bound = path[i].node->keys[path[i].childIndex];
+                    end = std::lower_bound(order.begin() + next, order.end(), bound,
+                                           [](const std::pair<K, int>& entry, const K& key) {
+                        return entry.first < key;
+                    }) - order.begin();
+                    break;
+                }
+            }
+            size_t take = std::min(end - next, static_cast<size_t>(LeafCapacity));
+            
+            // Merge the page with the batch run
+            K keys[2 * LeafCapacity];
+            T merged[2 * LeafCapacity];
+            int total = 0;
+            int pos = 0;
+            for (size_t i = next; i < next + take; i++) {
+                const K& key = order[i].first;
+                while (pos < leaf->count && leaf->keys[pos] < key) {
+                    keys[total] = leaf->keys[pos];
+                    merged[total++] = std::move(leaf->values[pos++]);
+                }
+                if (pos < leaf->count && !(key < leaf->keys[pos])) {
+                    pos++;      // Replaced by the batch value
+                } else {
+                    count++;
+                }
+                keys[total] = key;
+                merged[total++] = values[order[i].second];
+            }
+            while (pos < leaf->count) {
+                keys[total] = leaf->keys[pos];
+                merged[total++] = std::move(leaf->values[pos++]);
+            }
+            next += take;
+            
+            // Fill the page, leaving the new right page at least half full
+            int keep = total <= LeafCapacity ? total : std::min(LeafCapacity, total - LeafCapacity / 2);
+            std::copy(keys, keys + keep, leaf->keys);
+            std::move(merged, merged + keep, leaf->values);
+            if (keep < leaf->count) {
+                std::fill(leaf->values + keep, leaf->values + leaf->count, T());
+            }
+            leaf->count = keep;
+            if (keep == total) continue;
+            
+            LeafNode* right = new LeafNode();
+            std::copy(keys + keep, keys + total, right->keys);
+            std::move(merged + keep, merged + total, right->values);
+            right->count = total - keep;
+            right->next = leaf->next;
+            if (right->next) {
+                right->next->prev = right;
+            }
+            right->prev = leaf;
+            leaf->next = right;
+            insertIntoParent(path, depth, right->keys[0], right);
+        }
+    }
+    
+    // Range search: one descent, then a sequential walk along the leaf chain.
+    // Returns false if the visitor stopped early.
+    template<typename Visitor>
+    bool rangeSearch(const K& low, const K& high, Visitor&& visitor) const {
+        if (!root || high < low) return true;
+        
+        const LeafNode* leaf = findLeaf(low);
+        int pos = lowerBoundIndex(leaf->keys, leaf->count, low);
+        while (leaf) {
+            for (; pos < leaf->count; pos++) {
+                if (high < leaf->keys[pos]) return true;
+                if (!visitAndContinue(visitor, leaf->values[pos])) return false;
+            }
+            leaf = leaf->next;
+            pos = 0;
+        }
+        return true;
+    }
+    
+    void rangeSearch(const K& low, const K& high, std::function<void(const T&)> action) const {
+        rangeSearch<std::function<void(const T&)>&>(low, high, action);
+    }
+    
+    // In-order traversal (sorted by key); returns false if stopped early
+    template<typename Visitor>
+    bool inorderTraversal(Visitor&& visitor) const {
+        for (const LeafNode* leaf = firstLeaf; leaf; leaf = leaf->next) {
+            for (int i = 0; i < leaf->count; i++) {
+                if (!visitAndContinue(visitor, leaf->values[i])) return false;
+            }
+        }
+        return true;
+    }
+    
+    void inorderTraversal(std::function<void(const T&)> action) const {
+        inorderTraversal<std::function<void(const T&)>&>(action);
+    }
+    
+    // Get size
+    int size() const { return count; }
+    
+    // Check if empty
+    bool isEmpty() const { return count == 0; }
+    
+    // Get tree height (number of levels)
+    int getHeight() const { return height; }
+    
+    // Clear tree
+    void clear() {
+        clearRecursive(root);
+        root = nullptr;
+        firstLeaf = nullptr;
+        count = 0;
+        height = 0;
+    }
+    
+    // Convert to QList
+    QList<T> toQList() const {
+        QList<T> list;
+        list.reserve(count);
+        inorderTraversal([&list](const T& item) {
+            list.append(item);
+        });
+        return list;
+    }
+    
+    // Find all matching a condition
+    template<typename Predicate>
+    QList<T> findAll(Predicate&& condition) const {
+        QList<T> results;
+        inorderTraversal([&results, &condition](const T& item) {
+            if (condition(item)) {
+                results.append(item);
+            }
+        });
+        return results;
+    }
+    
+    QList<T> findAll(std::function<bool(const T&)> condition) const {
+        return findAll<std::function<bool(const T&)>&>(condition);
+    }
+
+private:
+    static int lowerBoundIndex(const K* keys, int n, const K& key) {
+        return static_cast<int>(std::lower_bound(keys, keys + n, key) - keys);
+    }
+    
+    static int upperBoundIndex(const K* keys, int n, const K& key) {
+        return static_cast<int>(std::upper_bound(keys, keys + n, key) - keys);
+    }
+    
+    LeafNode* findLeaf(const K& key, PathEntry* path, int& depth) const {
+        NodeBase* node = root;
+        while (!node->isLeaf) {
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            int index = upperBoundIndex(inner->keys, inner->count, key);
+            path[depth].node = inner;
+            path[depth].childIndex = index;
+            depth++;
+            node = inner->children[index];
+        }
+        return static_cast<LeafNode*>(node);
+    }
+    
+    LeafNode* findLeaf(const K& key) const {
+        NodeBase* node = root;
+        while (!node->isLeaf) {
+            InnerNode* inner = static_cast<InnerNode*>(node);
+            node = inner->children[upperBoundIndex(inner->keys, inner->count, key)];
+        }
+        return static_cast<LeafNode*>(node);
+    }
+    
+    void insertIntoLeaf(LeafNode* leaf, int pos, const K& key, const T& value) {
+        std::move_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + pos, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[pos] = key;
+        leaf->values[pos] = value;
+        leaf->count++;
+    }
+    
+    void eraseFromLeaf(LeafNode* leaf, int pos) {
+        std::move(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+        std::move(leaf->values + pos + 1, leaf->values + leaf->count, leaf->values + pos);
+        leaf->count--;
+        leaf->values[leaf->count] = T();
+    }
+    
+    // Remove keys[keyIndex] and children[childIndex] from an inner page
+    void eraseFromInner(InnerNode* node, int keyIndex, int childIndex) {
+        std::move(node->keys + keyIndex + 1, node->keys + node->count, node->keys + keyIndex);
+        std::move(node->children + childIndex + 1, node->children + node->count + 1,
+                  node->children + childIndex);
+        node->count--;
+    }
+    
+    // Push a separator and new right sibling up the recorded path, splitting full pages
+    void insertIntoParent(PathEntry* path, int depth, K separator, NodeBase* rightChild) {
+        while (depth > 0) {
+            PathEntry& entry = path[--depth];
+            InnerNode* node = entry.node;
+            int index = entry.childIndex;
+            
+            if (node->count < InnerCapacity) {
+                std::move_backward(node->keys + index, node->keys + node->count,
+                                   node->keys + node->count + 1);
+                std::move_backward(node->children + index + 1, node->children + node->count + 1,
+                                   node->children + node->count + 2);
+                node->keys[index] = separator;
+                node->children[index + 1] = rightChild;
+                node->count++;
+                return;
+            }
+            
+            // Inner page is full - split around the middle key
+            K keys[InnerCapacity + 1];
+            NodeBase* children[InnerCapacity + 2];
+            for (int i = 0, j = 0; i < InnerCapacity + 1; i++) {
+                keys[i] = (i == index) ? separator : node->keys[j++];
+            }
+            for (int i = 0, j = 0; i < InnerCapacity + 2; i++) {
+                children[i] = (i == index + 1) ? rightChild : node->children[j++];
+            }
+            
+            int mid = (InnerCapacity + 1) / 2;
+            InnerNode* right = new InnerNode();
+            
+            node->count = mid;
+            for (int i = 0; i < mid; i++) {
+                node->keys[i] = keys[i];
+                node->children[i] = children[i];
+            }
+            node->children[mid] = children[mid];
+            
+            right->count = InnerCapacity - mid;
+            for (int i = 0; i < right->count; i++) {
+                right->keys[i] = keys[mid + 1 + i];
+                right->children[i] = children[mid + 1 + i];
+            }
+            right->children[right->count] = children[InnerCapacity + 1];
+            
+            separator = keys[mid];
+            rightChild = right;
+        }
+        
+        // Root was split - grow the tree by one level
+        InnerNode* newRoot = new InnerNode();
+        newRoot->keys[0] = separator;
+        newRoot->children[0] = root;
+        newRoot->children[1] = rightChild;
+        newRoot->count = 1;
+        root = newRoot;
+        height++;
+    }
+    
+    void rebalanceLeaf(LeafNode* leaf, PathEntry* path, int depth) {
+        if (depth == 0) {
+            // Leaf is the root - it may hold any number of keys
+            if (leaf->count == 0) {
+                delete leaf;
+                root = nullptr;
+                firstLeaf = nullptr;
+                height = 0;
+            }
+            return;
+        }
+        
+        const int minKeys = LeafCapacity / 2;
+        if (leaf->count >= minKeys) return;
+        
+        InnerNode* parent = path[depth - 1].node;
+        int index = path[depth - 1].childIndex;
+        LeafNode* left = index > 0 ? static_cast<LeafNode*>(parent->children[index - 1]) : nullptr;
+        LeafNode* right = index < parent->count ? static_cast<LeafNode*>(parent->children[index + 1]) : nullptr;
+        
+        if (left && left->count > minKeys) {
+            // Borrow the largest entry of the left sibling
+            std::move_backward(leaf->keys, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+            std::move_backward(leaf->values, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+            leaf->keys[0] = std::move(left->keys[left->count - 1]);
+            leaf->values[0] = std::move(left->values[left->count - 1]);
+            left->values[left->count - 1] = T();
+            left->count--;
+            leaf->count++;
+            parent->keys[index - 1] = leaf->keys[0];
+            return;
+        }
+        
+        if (right && right->count > minKeys) {
+            // Borrow the smallest entry of the right sibling
+            leaf->keys[leaf->count] = std::move(right->keys[0]);
+            leaf->values[leaf->count] = std::move(right->values[0]);
+            leaf->count++;
+            eraseFromLeaf(right, 0);
+            parent->keys[index] = right->keys[0];
+            return;
+        }
+        
+        // Both siblings are at minimum - merge with one of them
+        LeafNode* target = left ? left : leaf;
+        LeafNode* source = left ? leaf : right;
+        for (int i = 0; i < source->count; i++) {
+            target->keys[target->count + i] = std::move(source->keys[i]);
+            target->values[target->count + i] = std::move(source->values[i]);
+        }
+        target->count += source->count;
+        target->next = source->next;
+        if (source->next) {
+            source->next->prev = target;
+        }
+        delete source;
+        
+        if (left) {
+            eraseFromInner(parent, index - 1, index);
+        } else {
+            eraseFromInner(parent, index, index + 1);
+        }
+        rebalanceInner(path, depth - 1);
+    }
+    
+    void rebalanceInner(PathEntry* path, int level) {
+        const int minKeys = InnerCapacity / 2;
+        
+        while (true) {
+            InnerNode* node = path[level].node;
+            
+            if (level == 0) {
+                // Root with a single child - shrink the tree by one level
+                if (node->count == 0) {
+                    root = node->children[0];
+                    delete node;
+                    height--;
+                }
+                return;
+            }
+            
+            if (node->count >= minKeys) return;
+            
+            InnerNode* parent = path[level - 1].node;
+            int index = path[level - 1].childIndex;
+            InnerNode* left = index > 0 ? static_cast<InnerNode*>(parent->children[index - 1]) : nullptr;
+            InnerNode* right = index < parent->count ? static_cast<InnerNode*>(parent->children[index + 1]) : nullptr;
+            
+            if (left && left->count > minKeys) {
+                // Rotate through the parent separator from the left sibling
+                std::move_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+                std::move_backward(node->children, node->children + node->count + 1,
+                                   node->children + node->count + 2);
+                node->keys[0] = parent->keys[index - 1];
+                node->children[0] = left->children[left->count];
+                parent->keys[index - 1] = left->keys[left->count - 1];
+                left->count--;
+                node->count++;
+                return;
+            }
+            
+            if (right && right->count > minKeys) {
+                // Rotate through the parent separator from the right sibling
+                node->keys[node->count] = parent->keys[index];
+                node->children[node->count + 1] = right->children[0];
+                node->count++;
+                parent->keys[index] = right->keys[0];
+                std::move(right->keys + 1, right->keys + right->count, right->keys);
+                std::move(right->children + 1, right->children + right->count + 1, right->children);
+                right->count--;
+                return;
+            }
+            
+            // Merge with a sibling, pulling the separator down between them
+            InnerNode* target = left ? left : node;
+            InnerNode* source = left ? node : right;
+            int separatorIndex = left ? index - 1 : index;
+            
+            target->keys[target->count] = parent->keys[separatorIndex];
+            for (int i = 0; i < source->count; i++) {
+                target->keys[target->count + 1 + i] = source->keys[i];
+            }
+            for (int i = 0; i <= source->count; i++) {
+                target->children[target->count + 1 + i] = source->children[i];
+            }
+            target->count += 1 + source->count;
+            delete source;
+            
+            eraseFromInner(parent, separatorIndex, separatorIndex + 1);
+            level--;
+        }
+    }
+    
+    bool isUnderfull(const NodeBase* node) const {
+        return node->count < (node->isLeaf ? LeafCapacity / 2 : InnerCapacity / 2);
+    }
+    
+    // Remove the keys in [low, high] below node and return how many.
+    // Children wholly inside the range are freed, and the children left on
+    // the edges are repaired; node itself may be left underfull (even with a
+    // single child, whose own edge may then be underfull) for the caller.
+    int eraseBelow(NodeBase* node, const K& low, const K& high) {
+        if (node->isLeaf) {
+            LeafNode* leaf = static_cast<LeafNode*>(node);
+            int from = lowerBoundIndex(leaf->keys, leaf->count, low);
+            int to = upperBoundIndex(leaf->keys, leaf->count, high);
+            if (from >= to) return 0;
+            std::move(leaf->keys + to, leaf->keys + leaf->count, leaf->keys + from);
+            std::move(leaf->values + to, leaf->values + leaf->count, leaf->values + from);
+            std::fill(leaf->values + leaf->count - (to - from), leaf->values + leaf->count, T());
+            leaf->count -= to - from;
+            return to - from;
+        }
+        
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        int first = upperBoundIndex(inner->keys, inner->count, low);
+        int last = upperBoundIndex(inner->keys, inner->count, high);
+        int removed = eraseBelow(inner->children[first], low, high);
+        if (last > first) {
+            removed += eraseBelow(inner->children[last], low, high);
+            for (int i = first + 1; i < last; i++) {
+                removed += discardSubtree(inner->children[i]);
+            }
+            
+            // Keep children[first] and children[last]; keys[last - 1] still
+            // separates them
+            std::move(inner->keys + last - 1, inner->keys + inner->count, inner->keys + first);
+            std::move(inner->children + last, inner->children + inner->count + 1,
+                      inner->children + first + 1);
+            inner->count -= last - first - 1;
+        }
+        repairAround(inner, first);
+        return removed;
+    }
+    
+    // Free a subtree whose keys are all being removed, unlinking its leaves
+    // from the chain first. Returns how many keys it held.
+    int discardSubtree(NodeBase* node) {
+        NodeBase* leftmost = node;
+        NodeBase* rightmost = node;
+        while (!leftmost->isLeaf) {
+            leftmost = static_cast<InnerNode*>(leftmost)->children[0];
+            InnerNode* inner = static_cast<InnerNode*>(rightmost);
+            rightmost = inner->children[inner->count];
+        }
+        LeafNode* first = static_cast<LeafNode*>(leftmost);
+        LeafNode* last = static_cast<LeafNode*>(rightmost);
+        
+        int keys = 0;
+        for (LeafNode* leaf = first; leaf != last->next; leaf = leaf->next) {
+            keys += leaf->count;
+        }
+        if (first->prev) {
+            first->prev->next = last->next;
+        } else {
+            firstLeaf = last->next;
+        }
+        if (last->next) {
+            last->next->prev = first->prev;
+        }
+        clearRecursive(node);
+        return keys;
+    }
+    
+    // Join underfull children of parent with a neighbour until none is left
+    // among children[index] and children[index + 1] (and any page a join
+    // reached on their left), or parent has a single child
+    void repairAround(InnerNode* parent, int index) {
+        int from = index;
+        int to = index + 1;
+        bool joined = true;
+        while (joined && parent->count > 0) {
+            joined = false;
+            to = std::min(to, parent->count);
+            for (int i = from; i <= to && !joined; i++) {
+                if (isUnderfull(parent->children[i])) {
+                    int left = i > 0 ? i - 1 : 0;
+                    joinChildren(parent, left);
+                    from = std::min(from, left);
+                    joined = true;
+                }
+            }
+        }
+    }
+    
+    // Merge children[left] and children[left + 1] into one page if they fit,
+    // otherwise share their entries evenly. Unlike the single-key borrow and
+    // merge of remove(), either page may be far below half full.
+    void joinChildren(InnerNode* parent, int left) {
+        if (parent->children[left]->isLeaf) {
+            LeafNode* a = static_cast<LeafNode*>(parent->children[left]);
+            LeafNode* b = static_cast<LeafNode*>(parent->children[left + 1]);
+            int total = a->count + b->count;
+            if (total <= LeafCapacity) {
+                std::move(b->keys, b->keys + b->count, a->keys + a->count);
+                std::move(b->values, b->values + b->count, a->values + a->count);
+                a->count = total;
+                a->next = b->next;
+                if (b->next) {
+                    b->next->prev = a;
+                }
+                delete b;
+                eraseFromInner(parent, left, left + 1);
+                return;
+            }
+            
+            int share = total / 2;
+            if (a->count < share) {
+                int moved = share - a->count;
+                std::move(b->keys, b->keys + moved, a->keys + a->count);
+                std::move(b->values, b->values + moved, a->values + a->count);
+                std::move(b->keys + moved, b->keys + b->count, b->keys);
+                std::move(b->values + moved, b->values + b->count, b->values);
+                std::fill(b->values + b->count - moved, b->values + b->count, T());
+                a->count += moved;
+                b->count -= moved;
+            } else {
+                int moved = a->count - share;
+                std::move_backward(b->keys, b->keys + b->count, b->keys + b->count + moved);
+                std::move_backward(b->values, b->values + b->count, b->values + b->count + moved);
+                std::move(a->keys + share, a->keys + a->count, b->keys);
+                std::move(a->values + share, a->values + a->count, b->values);
+                std::fill(a->values + share, a->values + a->count, T());
+                a->count = share;
+                b->count += moved;
+            }
+            parent->keys[left] = b->keys[0];
+            return;
+        }
+        
+        // Inner pages: lay both out as one sequence around the parent's
+        // separator. Pages below the seam between them (a's last child and
+        // b's first) may be underfull too, so they are repaired afterwards.
+        InnerNode* a = static_cast<InnerNode*>(parent->children[left]);
+        InnerNode* b = static_cast<InnerNode*>(parent->children[left + 1]);
+        int seam = a->count;
+        int total = a->count + 1 + b->count;
+        K keys[2 * InnerCapacity + 1];
+        NodeBase* children[2 * InnerCapacity + 2];
+        std::copy(a->keys, a->keys + a->count, keys);
+        keys[a->count] = parent->keys[left];
+        std::copy(b->keys, b->keys + b->count, keys + a->count + 1);
+        std::copy(a->children, a->children + a->count + 1, children);
+        std::copy(b->children, b->children + b->count + 1, children + a->count + 1);
+        
+        if (total <= InnerCapacity) {
+            std::copy(keys, keys + total, a->keys);
+            std::copy(children, children + total + 1, a->children);
+            a->count = total;
+            delete b;
+            eraseFromInner(parent, left, left + 1);
+            repairAround(a, seam);
+            return;
+        }
+        
+        int share = total / 2;
+        std::copy(keys, keys + share, a->keys);
+        std::copy(children, children + share + 1, a->children);
+        a->count = share;
+        parent->keys[left] = keys[share];
+        b->count = total - share - 1;
+        std::copy(keys + share + 1, keys + total, b->keys);
+        std::copy(children + share + 1, children + total + 1, b->children);
+        
+        if (seam < share) {
+            repairAround(a, seam);
+        } else if (seam > share) {
+            repairAround(b, seam - share - 1);
+        } else {
+            repairAround(a, share);
+            repairAround(b, 0);
+        }
+    }
+    
+    void clearRecursive(NodeBase* node) {
+        if (!node) return;
+        if (node->isLeaf) {
+            delete static_cast<LeafNode*>(node);
+            return;
+        }
+        InnerNode* inner = static_cast<InnerNode*>(node);
+        for (int i = 0; i <= inner->count; i++) {
+            clearRecursive(inner->children[i]);
+        }
+        delete inner;
+    }
+};
+
+
+// ============================================================================
+// HASH MAP - Open Addressing Table for O(1) Lookups by Integer Key
+// ============================================================================
+// Linear probing over a power-of-two table that is kept at most half full.
+// Removal shifts the rest of the probe run back, so no tombstones are needed.
+
+// Fibonacci hashing: the high bits of the product spread sequential IDs
+struct IntegerHash {
+    quint64 operator()(quint64 key) const { return key * 0x9E3779B97F4A7C15ULL; }
+};
+
+template<typename K, typename V, typename Hash = IntegerHash>
+class HashMap {
+private:
+    struct Slot {
+        K key;
+        V value;
+        bool used;
+        
+        Slot() : key(), value(), used(false) {}
+    };
+    
+    static const int MinCapacity = 16;
+    
+    std::vector<Slot> table;
+    int count;
+    int shift;      // 64 - log2(capacity): selects the high hash bits
+    Hash hasher;
+
+public:
+    HashMap() : count(0) {
+        allocate(MinCapacity);
+    }
+    
+    // Insert or overwrite; returns true if the key was new
+    bool insert(const K& key, const V& value) {
+        bool inserted;
+        slotFor(key, inserted).value = value;
+        return inserted;
+    }
+    
+    // Value for key, default-constructed and inserted if missing
+    V& operator[](const K& key) {
+        bool inserted;
+        return slotFor(key, inserted).value;
+    }
+    
+    // Find value by key
+    V* find(const K& key) {
+        int index = findIndex(key);
+        return index >= 0 ? &(table[index].value) : nullptr;
+    }
+    
+    const V* find(const K& key) const {
+        int index = findIndex(key);
+        return index >= 0 ? &(table[index].value) : nullptr;
+    }
+    
+    bool contains(const K& key) const { return findIndex(key) >= 0; }
+    
+    // Visit every (key, value) pair, in table order
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const {
+        for (const Slot& slot : table) {
+            if (slot.used) visitor(slot.key, slot.value);
+        }
+    }
+    
+    // Remove by key (backward-shift deletion)
+    bool remove(const K& key) {
+        int index = findIndex(key);
+        if (index < 0) return false;
+        
+        size_t mask = table.size() - 1;
+        size_t hole = static_cast<size_t>(index);
+        for (size_t next = (hole + 1) & mask; table[next].used; next = (next + 1) & mask) {
+            // Move the entry back unless its home lies cyclically in (hole, next]
+            size_t home = homeIndex(table[next].key);
+            bool staysPut = (hole < next) ? (home > hole && home <= next)
+                                          : (home > hole || home <= next);
+            if (!staysPut) {
+                table[hole] = std::move(table[next]);
+                hole = next;
+            }
+        }
+        table[hole] = Slot();
+        count--;
+        return true;
+    }
+    
+    // Make room for n entries without rehashing
+    void reserve(int n) {
+        int capacity = static_cast<int>(table.size());
+        while (n * 2 > capacity) capacity *= 2;
+        if (capacity != static_cast<int>(table.size())) rehash(capacity);
+    }
+    
+    // Get size
+    int size() const { return count; }
+    
+    // Check if empty
+    bool isEmpty() const { return count == 0; }
+    
+    // Clear map (capacity is kept)
+    void clear() {
+        std::fill(table.begin(), table.end(), Slot());
+        count = 0;
+    }
+
+private:
+    Slot& slotFor(const K& key, bool& inserted) {
+        if ((count + 1) * 2 > static_cast<int>(table.size())) {
+            rehash(static_cast<int>(table.size()) * 2);
+        }
+        
+        size_t mask = table.size() - 1;
+        for (size_t i = homeIndex(key); ; i = (i + 1) & mask) {
+            Slot& slot = table[i];
+            if (!slot.used) {
+                slot.key = key;
+                slot.used = true;
+                count++;
+                inserted = true;
+                return slot;
+            }
+            if (slot.key == key) {
+                inserted = false;
+                return slot;
+            }
+        }
+    }
+    
+    size_t homeIndex(const K& key) const {
+        return static_cast<size_t>(hasher(static_cast<quint64>(key)) >> shift);
+    }
+    
+    int findIndex(const K& key) const {
+        size_t mask = table.size() - 1;
+        for (size_t i = homeIndex(key); table[i].used; i = (i + 1) & mask) {
+            if (table[i].key == key) return static_cast<int>(i);
+        }
+        return -1;
+    }
+    
+    void allocate(int capacity) {
+        table.assign(capacity, Slot());
+        shift = 64;
+        for (int c = capacity; c > 1; c >>= 1) shift--;
+    }
+    
+    void rehash(int capacity) {
+        std::vector<Slot> old;
+        old.swap(table);
+        allocate(capacity);
+        
+        size_t mask = table.size() - 1;
+        for (Slot& slot : old) {
+            if (!slot.used) continue;
+            size_t i = homeIndex(slot.key);
+            while (table[i].used) i = (i + 1) & mask;
+            table[i] = std::move(slot);
+        }
+    }
+};
+
+
+// ============================================================================
+// ACTION LOG - Delta-Encoded Undo/Redo History
+// ============================================================================
+enum class ActionType {
+    ADD_EMPLOYEE,
+    EDIT_EMPLOYEE,
+    DELETE_EMPLOYEE,
+    APPROVE_LEAVE,
+    REJECT_LEAVE
+};
+
+// One encoded undo entry: fields are appended with put*() and read back in
+// the same order with get*(). Strings are stored as UTF-8 with a length.
+class ActionEntry {
+public:
+    ActionEntry() : readPos(0) {}
+    
+    void putByte(quint8 value) { putRaw(&value, sizeof(value)); }
+    void putInt(qint32 value) { putRaw(&value, sizeof(value)); }
+    void putInt64(qint64 value) { putRaw(&value, sizeof(value)); }
+    void putDouble(double value) { putRaw(&value, sizeof(value)); }
+    
+    void putString(const QString& value) {
+        QByteArray utf8 = value.toUtf8();
+        putInt(static_cast<qint32>(utf8.size()));
+        putRaw(utf8.constData(), static_cast<size_t>(utf8.size()));
+    }
+    
+    quint8 getByte() { quint8 value = 0; getRaw(&value, sizeof(value)); return value; }
+    qint32 getInt() { qint32 value = 0; getRaw(&value, sizeof(value)); return value; }
+    qint64 getInt64() { qint64 value = 0; getRaw(&value, sizeof(value)); return value; }
+    double getDouble() { double value = 0; getRaw(&value, sizeof(value)); return value; }
+    
+    QString getString() {
+        qint32 length = getInt();
+        if (length <= 0 || readPos + static_cast<size_t>(length) > bytes.size()) return QString();
+        QString value = QString::fromUtf8(bytes.data() + readPos, length);
+        readPos += static_cast<size_t>(length);
+        return value;
+    }
+    
+    // Replace the contents with raw encoded bytes and rewind the reader
+    void assign(const char* data, size_t length) {
+        bytes.assign(data, data + length);
+        readPos = 0;
+    }
+    
+    const char* data() const { return bytes.data(); }
+    size_t size() const { return bytes.size(); }
+    
+    void clear() {
+        bytes.clear();
+        readPos = 0;
+    }
+
+private:
+    void putRaw(const void* data, size_t length) {
+        const char* begin = static_cast<const char*>(data);
+        bytes.insert(bytes.end(), begin, begin + length);
+    }
+    
+    void getRaw(void* out, size_t length) {
+        if (readPos + length > bytes.size()) return;
+        std::memcpy(out, bytes.data() + readPos, length);
+        readPos += length;
+    }
+    
+    std::vector<char> bytes;
+    size_t readPos;
+};
+
+// Entries packed back to back in one byte buffer as [length][payload][length],
+// so the newest entry is popped from the back and the oldest dropped from the
+// front, both in O(entry size). The number of entries is bounded only by a
+// byte budget: pushing past it drops the oldest entries (the newest is always
+// kept). Dropped bytes at the front are compacted away once they make up half
+// the buffer, which keeps drops amortized O(1).
+class ActionLog {
+public:
+    static const int DefaultBudgetBytes = 64 * 1024;
+    
+    explicit ActionLog(int budgetBytes = DefaultBudgetBytes)
+        : start(0), entries(0), budgetBytes(budgetBytes) {}
+    
+    // Append an entry, then drop the oldest ones while over budget
+    void push(const ActionEntry& entry) {
+        quint32 length = static_cast<quint32>(entry.size());
+        putLength(length);
+        bytes.insert(bytes.end(), entry.data(), entry.data() + length);
+        putLength(length);
+        entries++;
+        trimToBudget();
+    }
+    
+    // Move the newest entry out
+    bool pop(ActionEntry& entry) {
+        if (entries == 0) return false;
+        quint32 length = lengthAt(bytes.size() - sizeof(quint32));
+        size_t payload = bytes.size() - sizeof(quint32) - length;
+        entry.assign(bytes.data() + payload, length);
+        bytes.resize(payload - sizeof(quint32));
+        entries--;
+        if (entries == 0) {
+            bytes.clear();
+            start = 0;
+        }
+        return true;
+    }
+    
+    // Change the budget; shrinking it drops the oldest entries right away
+    void setBudget(int budget) {
+        budgetBytes = budget;
+        trimToBudget();
+    }
+    
+    int budget() const { return budgetBytes; }
+    
+    // Bytes held by live entries, framing included
+    int bytesUsed() const { return static_cast<int>(bytes.size() - start); }
+    
+    int size() const { return entries; }
+    bool isEmpty() const { return entries == 0; }
+    
+    void clear() {
+        bytes.clear();
+        start = 0;
+        entries = 0;
+    }
+
+private:
+    void putLength(quint32 length) {
+        const char* raw = reinterpret_cast<const char*>(&length);
+        bytes.insert(bytes.end(), raw, raw + sizeof(length));
+    }
+    
+    quint32 lengthAt(size_t offset) const {
+        quint32 length;
+        std::memcpy(&length, bytes.data() + offset, sizeof(length));
+        return length;
+    }
+    
+    void trimToBudget() {
+        while (entries > 1 && bytesUsed() > budgetBytes) {
+            start += lengthAt(start) + 2 * sizeof(quint32);
+            entries--;
+        }
+        if (start > 0 && start >= bytes.size() / 2) {
+            bytes.erase(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(start));
+            start = 0;
+        }
+    }
+    
+    std::vector<char> bytes;
+    size_t start;       // Offset of the oldest live entry
+    int entries;
+    int budgetBytes;
+};
+
+
+// ============================================================================
+// ATTENDANCE KEY - Packed 64-bit composite key (Julian day + employee ID)
+// ============================================================================
+// High 32 bits hold the Julian day, low 32 bits the employee ID, so integer
+// order is date-major and matches the old "yyyy-MM-dd_<id>" ordering by date.
+struct AttendanceKey {
+    static quint64 make(const QDate& date, int employeeId) {
+        return (static_cast<quint64>(static_cast<quint32>(date.toJulianDay())) << 32) |
+               static_cast<quint32>(employeeId);
+    }
+    
+    static quint64 make(const AttendanceEntry& entry) {
+        return (static_cast<quint64>(static_cast<quint32>(entry.day)) << 32) |
+               static_cast<quint32>(entry.employeeId);
+    }
+    
+    // Smallest key on the given date
+    static quint64 lowerBound(const QDate& date) {
+        return make(date, 0);
+    }
+    
+    // Largest key on the given date
+    static quint64 upperBound(const QDate& date) {
+        return make(date, 0) | 0xFFFFFFFFull;
+    }
+    
+    // Employee-major variant for the per-employee index: employee ID in the
+    // high 32 bits, Julian day in the low 32 bits
+    static quint64 byEmployee(int employeeId, const QDate& date) {
+        return byEmployee(employeeId, static_cast<qint32>(date.toJulianDay()));
+    }
+    
+    static quint64 byEmployee(int employeeId, qint32 day) {
+        return (static_cast<quint64>(static_cast<quint32>(employeeId)) << 32) |
+               static_cast<quint32>(day);
+    }
+    
+    static quint64 byEmployee(const AttendanceEntry& entry) {
+        return (static_cast<quint64>(static_cast<quint32>(entry.employeeId)) << 32) |
+               static_cast<quint32>(entry.day);
+    }
+    
+    // Smallest employee-major key for the given employee
+    static quint64 employeeLowerBound(int employeeId) {
+        return static_cast<quint64>(static_cast<quint32>(employeeId)) << 32;
+    }
+    
+    // Largest employee-major key for the given employee
+    static quint64 employeeUpperBound(int employeeId) {
+        return employeeLowerBound(employeeId) | 0xFFFFFFFFull;
+    }
+    
+    static QDate date(quint64 key) {
+        return QDate::fromJulianDay(static_cast<qint64>(key >> 32));
+    }
+    
+    static int employeeId(quint64 key) {
+        return static_cast<int>(key & 0xFFFFFFFFull);
+    }
+};
+
+// ============================================================================
+// LEAVE KEY - Packed 64-bit key for a leave request (employee ID + start day)
+// ============================================================================
+// A request is identified by its employee and start date, the same pair
+// processLeaveRequest() is called with.
+struct LeaveKey {
+    static quint64 make(int employeeId, const QDate& startDate) {
+        return (static_cast<quint64>(static_cast<quint32>(employeeId)) << 32) |
+               static_cast<quint32>(startDate.toJulianDay());
+    }
+    
+    static quint64 make(const LeaveRequest& request) {
+        return make(request.getEmployeeId(), request.getStartDate());
+    }
+};
+
+
+// ============================================================================
+// ATTENDANCE COLUMNS - Struct-of-Arrays Copy for Aggregate Reports
+// ============================================================================
+// Attendance entries in AttendanceKey order (day, then employee ID), one
+// contiguous array per field. A day range is a contiguous slice found by
+// binary search, and the summing kernel streams over it four records per
+// step with SSE2, instead of chasing tree pointers.
+
+// Totals over a set of attendance records
+struct AttendanceSummary {
+    int employeeId;             // 0 for company-wide totals
+    int days;                   // Records, i.e. days present
+    int clockedInDays;          // Records with a time in
+    qint64 clockInMinutes;      // Sum of time in, minutes since midnight
+    int completeDays;           // Records with both time in and time out
+    qint64 workedMinutes;       // Sum of (time out - time in) over complete records
+    
+    AttendanceSummary()
+        : employeeId(0), days(0), clockedInDays(0), clockInMinutes(0), completeDays(0), workedMinutes(0) {}
+    
+    double averageClockIn() const {     // Minutes since midnight
+        return clockedInDays > 0 ? double(clockInMinutes) / clockedInDays : 0.0;
+    }
+    double hoursWorked() const { return workedMinutes / 60.0; }
+    
+    // Count one record with the given times (AttendanceEntry::NoTime if missing)
+    void add(quint16 timeIn, quint16 timeOut) {
+        days++;
+        if (timeIn == AttendanceEntry::NoTime) return;
+        clockedInDays++;
+        clockInMinutes += timeIn;
+        if (timeOut == AttendanceEntry::NoTime) return;
+        completeDays++;
+        workedMinutes += int(timeOut) - int(timeIn);
+    }
+};
+
+class AttendanceColumns {
+private:
+    std::vector<qint32> employeeIds;
+    std::vector<qint32> days;
+    std::vector<quint16> timesIn;
+    std::vector<quint16> timesOut;
+    
+    // Records per SIMD pass: each 32-bit lane sums BlockRecords / 4 values
+    // below 1440 in magnitude, so it stays below 2^31 until it is flushed
+    static const int BlockRecords = 1 << 22;
+    
+    AttendanceSummary sumRange(int begin, int end) const {
+        AttendanceSummary total;
+        int i = begin;
+        
+#ifdef ATTENDANCE_SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i allSet = _mm_set1_epi32(-1);
+        const __m128i noTime = _mm_set1_epi32(AttendanceEntry::NoTime);
+        
+        while (end - i >= 4) {
+            int blockEnd = (end - i > BlockRecords) ? i + BlockRecords : end;
+            // Lane counters subtract the all-ones masks, i.e. add 1 per match
+            __m128i inCount = zero, inSum = zero, doneCount = zero, workedSum = zero;
+            
+            for (; blockEnd - i >= 4; i += 4) {
+                // Widen four 16-bit times to 32-bit lanes
+                __m128i in = _mm_unpacklo_epi16(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&timesIn[i])), zero);
+                __m128i out = _mm_unpacklo_epi16(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&timesOut[i])), zero);
+                
+                __m128i hasIn = _mm_xor_si128(_mm_cmpeq_epi32(in, noTime), allSet);
+                __m128i done = _mm_andnot_si128(_mm_cmpeq_epi32(out, noTime), hasIn);
+                
+                inCount = _mm_sub_epi32(inCount, hasIn);
+                inSum = _mm_add_epi32(inSum, _mm_and_si128(in, hasIn));
+                doneCount = _mm_sub_epi32(doneCount, done);
+                workedSum = _mm_add_epi32(workedSum, _mm_and_si128(_mm_sub_epi32(out, in), done));
+            }
+            
+            total.clockedInDays += horizontalSum(inCount);
+            total.clockInMinutes += horizontalSum(inSum);
+            total.completeDays += horizontalSum(doneCount);
+            total.workedMinutes += horizontalSum(workedSum);
+        }
+        total.days = i - begin;
+#endif
+        
+        // Scalar tail (and the whole range without SSE2)
+        for (; i < end; ++i) {
+            total.add(timesIn[i], timesOut[i]);
+        }
+        return total;
+    }
+    
+#ifdef ATTENDANCE_SIMD_SSE2
+    // Sum of the four signed lanes. The lanes fit in 32 bits but their sum
+    // over a full block does not, so they are sign-extended to 64 bits first.
+    static qint64 horizontalSum(__m128i v) {
+        __m128i sign = _mm_srai_epi32(v, 31);
+        __m128i sum = _mm_add_epi64(_mm_unpacklo_epi32(v, sign), _mm_unpackhi_epi32(v, sign));
+        sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+        qint64 result;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&result), sum);
+        return result;
+    }
+#endif
+    
+    // First index whose day is >= day
+    int lowerIndex(qint32 day) const {
+        return static_cast<int>(std::lower_bound(days.begin(), days.end(), day) - days.begin());
+    }
+    
+public:
+    // Appends in key order; returns false (and appends nothing) otherwise
+    bool append(const AttendanceEntry& entry) {
+        if (!days.empty() && (entry.day < days.back() ||
+                              (entry.day == days.back() && entry.employeeId <= employeeIds.back()))) {
+            return false;
+        }
+        employeeIds.push_back(entry.employeeId);
+        days.push_back(entry.day);
+        timesIn.push_back(entry.timeIn);
+        timesOut.push_back(entry.timeOut);
+        return true;
+    }
+    
+    void reserve(int n) {
+        employeeIds.reserve(n);
+        days.reserve(n);
+        timesIn.reserve(n);
+        timesOut.reserve(n);
+    }
+    
+    void clear() {
+        employeeIds.clear();
+        days.clear();
+        timesIn.clear();
+        timesOut.clear();
+    }
+    
+    int size() const { return static_cast<int>(days.size()); }
+    bool isEmpty() const { return days.empty(); }
+    
+    // All records on days [firstDay, lastDay] (Julian days, inclusive)
+    AttendanceSummary summarize(qint32 firstDay, qint32 lastDay) const {
+        if (firstDay > lastDay) return AttendanceSummary();
+        return sumRange(lowerIndex(firstDay), lowerIndex(lastDay + 1));
+    }
+    
+    // Per-employee totals on days [firstDay, lastDay] in one sequential pass,
+    // ordered by employee ID. The scatter by ID is scalar.
+    std::vector<AttendanceSummary> summarizeByEmployee(qint32 firstDay, qint32 lastDay) const {
+        std::vector<AttendanceSummary> result;
+        if (firstDay > lastDay) return result;
+        
+        HashMap<int, int> positions;    // Employee ID -> index in result + 1 (0 = not seen)
+        int end = lowerIndex(lastDay + 1);
+        for (int i = lowerIndex(firstDay); i < end; ++i) {
+            int& position = positions[employeeIds[i]];
+            if (position == 0) {
+                result.push_back(AttendanceSummary());
+                result.back().employeeId = employeeIds[i];
+                position = static_cast<int>(result.size());
+            }
+            result[position - 1].add(timesIn[i], timesOut[i]);
+        }
+        
+        std::sort(result.begin(), result.end(),
+                  [](const AttendanceSummary& a, const AttendanceSummary& b) { return a.employeeId < b.employeeId; });
+        return result;
+    }
+};
+
+// ============================================================================
+// PRESENCE BITMAP - Per-Employee Day Bitset for Present/Absent Counts
+// ============================================================================
+// Bit i of word w stands for Julian day w * 64 + i. Counting the days in a
+// range is a popcount per 64-day word (two words for a month, seven for a
+// year), and absences are working days whose bit is clear.
+
+class PresenceBitmap {
+private:
+    std::vector<quint64> words;
+    qint32 firstWord;               // Word index of words[0]
+    
+    static qint32 wordOf(qint32 day) { return day >> 6; }
+    
+    quint64 wordAt(qint32 index) const {
+        qint32 offset = index - firstWord;
+        return (offset >= 0 && offset < static_cast<qint32>(words.size())) ? words[offset] : 0;
+    }
+    
+    // Sum of popcount(bits(wordIndex, word)) over the words of [firstDay, lastDay]
+    template<typename Bits>
+    int countRange(qint32 firstDay, qint32 lastDay, Bits bits) const {
+        if (firstDay > lastDay) return 0;
+        qint32 low = wordOf(firstDay);
+        qint32 high = wordOf(lastDay);
+        int total = 0;
+        for (qint32 w = low; w <= high; ++w) {
+            quint64 range = ~0ULL;
+            if (w == low) range &= ~0ULL << (firstDay & 63);
+            if (w == high) range &= ~0ULL >> (63 - (lastDay & 63));
+            total += qPopulationCount(bits(w, wordAt(w)) & range);
+        }
+        return total;
+    }
+    
+public:
+    PresenceBitmap() : firstWord(0) {}
+    
+    void set(qint32 day) {
+        qint32 index = wordOf(day);
+        if (words.empty()) {
+            firstWord = index;
+        } else if (index < firstWord) {
+            words.insert(words.begin(), firstWord - index, 0);
+            firstWord = index;
+        }
+        qint32 offset = index - firstWord;
+        if (offset >= static_cast<qint32>(words.size())) {
+            words.resize(offset + 1, 0);
+        }
+        words[offset] |= 1ULL << (day & 63);
+    }
+    
+    void reset(qint32 day) {
+        qint32 offset = wordOf(day) - firstWord;
+        if (offset >= 0 && offset < static_cast<qint32>(words.size())) {
+            words[offset] &= ~(1ULL << (day & 63));
+        }
+    }
+    
+    bool test(qint32 day) const { return (wordAt(wordOf(day)) >> (day & 63)) & 1; }
+    
+    // Days present in [firstDay, lastDay]
+    int count(qint32 firstDay, qint32 lastDay) const {
+        return countRange(firstDay, lastDay, [](qint32, quint64 word) { return word; });
+    }
+    
+    // Working days (Monday to Friday) in [firstDay, lastDay] without presence
+    int countAbsent(qint32 firstDay, qint32 lastDay) const {
+        return countRange(firstDay, lastDay, [](qint32 w, quint64 word) { return workingDays(w) & ~word; });
+    }
+    
+    // Working days in [firstDay, lastDay]
+    static int countWorkingDays(qint32 firstDay, qint32 lastDay) {
+        return PresenceBitmap().countAbsent(firstDay, lastDay);
+    }
+    
+    // Monday-to-Friday bits of word w. Julian day 0 is a Monday, so the
+    // weekday of a word's first day is (w * 64) mod 7: seven masks cover all words.
+    static quint64 workingDays(qint32 w) {
+        static const struct Masks {
+            quint64 byOffset[7];
+            Masks() {
+                for (int r = 0; r < 7; ++r) {
+                    byOffset[r] = 0;
+                    for (int i = 0; i < 64; ++i) {
+                        if ((r + i) % 7 < 5) byOffset[r] |= 1ULL << i;
+                    }
+                }
+            }
+        } masks;
+        int r = static_cast<int>((static_cast<qint64>(w) * 64) % 7);
+        return masks.byOffset[r < 0 ? r + 7 : r];
+    }
+    
+    bool isEmpty() const { return words.empty(); }
+    void clear() { words.clear(); firstWord = 0; }
+};
+
+// ============================================================================
+// ATTENDANCE POSTINGS - Compressed Per-Employee Attendance History
+// ============================================================================
+// One employee's archived records in day order, split into blocks of up to
+// 2 * BlockSize entries. Each entry is the day delta from the previous entry
+// as a varint (one byte for consecutive days) followed by time in and time
+// out packed into 3 bytes, about 4 bytes per record. The block headers
+// (first day, last day, count) act as skip pointers: a range query
+// binary-searches them and decodes only the blocks it overlaps.
+
+class AttendancePostings {
+private:
+    struct Block {
+        qint32 firstDay;
+        qint32 lastDay;
+        int count;
+        std::vector<quint8> bytes;
+    };
+    
+    static const int BlockSize = 128;
+    static const quint32 PackedNoTime = 0x7FF;     // Minutes fit in 11 bits
+    
+    std::vector<Block> blocks;
+    qint32 employeeId;
+    int total;
+    
+    static void encode(std::vector<quint8>& out, qint32 previousDay, const AttendanceEntry& entry) {
+        quint32 delta = static_cast<quint32>(entry.day - previousDay);
+        while (delta >= 0x80) {
+            out.push_back(static_cast<quint8>(delta | 0x80));
+            delta >>= 7;
+        }
+        out.push_back(static_cast<quint8>(delta));
+        
+        quint32 in = entry.timeIn == AttendanceEntry::NoTime ? PackedNoTime : entry.timeIn;
+        quint32 out11 = entry.timeOut == AttendanceEntry::NoTime ? PackedNoTime : entry.timeOut;
+        quint32 packed = in | (out11 << 11);
+        out.push_back(static_cast<quint8>(packed));
+        out.push_back(static_cast<quint8>(packed >> 8));
+        out.push_back(static_cast<quint8>(packed >> 16));
+    }
+    
+    // Decodes the entry at pos into entry (day relative to previousDay)
+    static const quint8* decode(const quint8* pos, qint32 previousDay, AttendanceEntry& entry) {
+        quint32 delta = 0;
+        int shift = 0;
+        while (*pos & 0x80) {
+            delta |= static_cast<quint32>(*pos++ & 0x7F) << shift;
+            shift += 7;
+        }
+        delta |= static_cast<quint32>(*pos++) << shift;
+        entry.day = previousDay + static_cast<qint32>(delta);
+        
+        quint32 packed = pos[0] | (static_cast<quint32>(pos[1]) << 8) | (static_cast<quint32>(pos[2]) << 16);
+        quint32 in = packed & 0x7FF;
+        quint32 out = (packed >> 11) & 0x7FF;
+        entry.timeIn = in == PackedNoTime ? AttendanceEntry::NoTime : static_cast<quint16>(in);
+        entry.timeOut = out == PackedNoTime ? AttendanceEntry::NoTime : static_cast<quint16>(out);
+        return pos + 3;
+    }
+    
+    // Visits the entries of one block in day order; false if the visitor stopped
+    template<typename Visitor>
+    bool decodeBlock(const Block& block, Visitor&& visitor) const {
+        AttendanceEntry entry;
+        entry.employeeId = employeeId;
+        entry.day = block.firstDay;
+        const quint8* pos = block.bytes.data();
+        for (int i = 0; i < block.count; ++i) {
+            pos = decode(pos, entry.day, entry);
+            if (!visitAndContinue(visitor, entry)) return false;
+        }
+        return true;
+    }
+    
+    void encodeBlock(Block& block, const std::vector<AttendanceEntry>& entries, int begin, int end) {
+        block.firstDay = entries[begin].day;
+        block.lastDay = entries[end - 1].day;
+        block.count = end - begin;
+        block.bytes.clear();
+        qint32 previousDay = block.firstDay;
+        for (int i = begin; i < end; ++i) {
+            encode(block.bytes, previousDay, entries[i]);
+            previousDay = entries[i].day;
+        }
+    }
+    
+    // Re-encodes block index from entries, splitting it if it grew too large
+    void rewriteBlock(int index, const std::vector<AttendanceEntry>& entries) {
+        int n = static_cast<int>(entries.size());
+        if (n == 0) {
+            blocks.erase(blocks.begin() + index);
+            return;
+        }
+        if (n > 2 * BlockSize) {
+            blocks.insert(blocks.begin() + index + 1, Block());
+            encodeBlock(blocks[index + 1], entries, n / 2, n);
+            n /= 2;
+        }
+        encodeBlock(blocks[index], entries, 0, n);
+    }
+    
+    // Drops the entries of block index that fall in [firstDay, lastDay]
+    int trimBlock(int index, qint32 firstDay, qint32 lastDay) {
+        std::vector<AttendanceEntry> kept;
+        kept.reserve(blocks[index].count);
+        decodeBlock(blocks[index], [&](const AttendanceEntry& e) {
+            if (e.day < firstDay || e.day > lastDay) kept.push_back(e);
+        });
+        int removed = blocks[index].count - static_cast<int>(kept.size());
+        if (removed > 0) {
+            rewriteBlock(index, kept);
+        }
+        return removed;
+    }
+    
+    // First block whose last day is >= day
+    int blockFor(qint32 day) const {
+        int low = 0, high = static_cast<int>(blocks.size());
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (blocks[mid].lastDay < day) low = mid + 1;
+            else high = mid;
+        }
+        return low;
+    }
+    
+public:
+    AttendancePostings() : employeeId(0), total(0) {}
+    
+    // Adds an entry after the last one: O(1) amortized
+    void append(const AttendanceEntry& entry) {
+        if (!blocks.empty() && entry.day <= blocks.back().lastDay) {
+            insert(entry);
+            return;
+        }
+        employeeId = entry.employeeId;
+        if (blocks.empty() || blocks.back().count >= BlockSize) {
+            blocks.push_back(Block());
+            blocks.back().firstDay = entry.day;
+            blocks.back().count = 0;
+        }
+        Block& block = blocks.back();
+        encode(block.bytes, block.count == 0 ? block.firstDay : block.lastDay, entry);
+        block.lastDay = entry.day;
+        block.count++;
+        total++;
+    }
+    
+    // Adds or replaces the entry for its day: O(BlockSize)
+    void insert(const AttendanceEntry& entry) {
+        employeeId = entry.employeeId;
+        if (blocks.empty() || entry.day > blocks.back().lastDay) {
+            append(entry);
+            return;
+        }
+        
+        int index = blockFor(entry.day);
+        std::vector<AttendanceEntry> entries;
+        entries.reserve(blocks[index].count + 1);
+        decodeBlock(blocks[index], [&entries](const AttendanceEntry& e) { entries.push_back(e); });
+        
+        auto pos = std::lower_bound(entries.begin(), entries.end(), entry.day,
+                                    [](const AttendanceEntry& e, qint32 day) { return e.day < day; });
+        if (pos != entries.end() && pos->day == entry.day) {
+            *pos = entry;
+        } else {
+            entries.insert(pos, entry);
+            total++;
+        }
+        rewriteBlock(index, entries);
+    }
+    
+    // Removes the entries on days [firstDay, lastDay]. Blocks inside the range
+    // are dropped whole; only the two boundary blocks are re-encoded.
+    int eraseRange(qint32 firstDay, qint32 lastDay) {
+        if (lastDay < firstDay) return 0;
+        int removed = 0;
+        int index = blockFor(firstDay);
+        if (index < static_cast<int>(blocks.size()) && blocks[index].firstDay < firstDay) {
+            removed += trimBlock(index, firstDay, lastDay);
+            index++;
+        }
+        int end = index;
+        while (end < static_cast<int>(blocks.size()) && blocks[end].lastDay <= lastDay) {
+            removed += blocks[end++].count;
+        }
+        blocks.erase(blocks.begin() + index, blocks.begin() + end);
+        if (index < static_cast<int>(blocks.size()) && blocks[index].firstDay <= lastDay) {
+            removed += trimBlock(index, firstDay, lastDay);
+        }
+        total -= removed;
+        return removed;
+    }
+    
+    // Removes the entry for day: O(BlockSize)
+    bool remove(qint32 day) {
+        int index = blockFor(day);
+        if (index == static_cast<int>(blocks.size()) || blocks[index].firstDay > day) return false;
+        
+        std::vector<AttendanceEntry> entries;
+        entries.reserve(blocks[index].count);
+        bool found = false;
+        decodeBlock(blocks[index], [&](const AttendanceEntry& e) {
+            if (e.day == day) found = true;
+            else entries.push_back(e);
+        });
+        if (!found) return false;
+        
+        total--;
+        rewriteBlock(index, entries);
+        return true;
+    }
+    
+    bool find(qint32 day, AttendanceEntry& result) const {
+        bool found = false;
+        rangeSearch(day, day, [&](const AttendanceEntry& e) {
+            result = e;
+            found = true;
+        });
+        return found;
+    }
+    
+    // Visits entries on days [firstDay, lastDay] in order; decodes only the
+    // overlapping blocks. Returns false if the visitor stopped early.
+    template<typename Visitor>
+    bool rangeSearch(qint32 firstDay, qint32 lastDay, Visitor&& visitor) const {
+        for (int i = blockFor(firstDay); i < static_cast<int>(blocks.size()); ++i) {
+            if (blocks[i].firstDay > lastDay) break;
+            bool keepGoing = true;
+            decodeBlock(blocks[i], [&](const AttendanceEntry& e) {
+                if (e.day < firstDay) return true;
+                if (e.day > lastDay || !visitAndContinue(visitor, e)) {
+                    keepGoing = e.day > lastDay;
+                    return false;
+                }
+                return true;
+            });
+            if (!keepGoing) return false;
+        }
+        return true;
+    }
+    
+    // Blocks inside the range are counted from their headers without decoding
+    int countInRange(qint32 firstDay, qint32 lastDay) const {
+        int result = 0;
+        for (int i = blockFor(firstDay); i < static_cast<int>(blocks.size()); ++i) {
+            const Block& block = blocks[i];
+            if (block.firstDay > lastDay) break;
+            if (block.firstDay >= firstDay && block.lastDay <= lastDay) {
+                result += block.count;
+            } else {
+                decodeBlock(block, [&](const AttendanceEntry& e) {
+                    if (e.day >= firstDay && e.day <= lastDay) result++;
+                });
+            }
+        }
+        return result;
+    }
+    
+    // Most recent entry
+    bool last(AttendanceEntry& result) const {
+        if (blocks.empty()) return false;
+        decodeBlock(blocks.back(), [&result](const AttendanceEntry& e) { result = e; });
+        return true;
+    }
+    
+    int size() const { return total; }
+    bool isEmpty() const { return total == 0; }
+    
+    int memoryUsage() const {
+        int bytes = static_cast<int>(blocks.capacity() * sizeof(Block));
+        for (const Block& block : blocks) {
+            bytes += static_cast<int>(block.bytes.capacity());
+        }
+        return bytes;
+    }
+    
+    void clear() {
+        blocks.clear();
+        total = 0;
+    }
+};
+
+// Ordering of the pending leave queue
+enum class PendingLeaveOrder {
+    Submission,     // First submitted, first processed
+    StartDate,      // Earliest start date first (most urgent)
+    Custom          // Key set with DataManager::setPendingLeaveKey()
+};
+
+// ============================================================================
+// DATA MANAGER - Central Data Management with DSA
+// ============================================================================
+class DataManager {
+private:
+    // Doubly Linked List for Employee Management
+    DoublyLinkedList<Employee> m_employeeList;
+    
+    // Hash map from employee ID to its list node, for O(1) edit/unlink
+    typedef DoublyLinkedList<Employee>::Node EmployeeNode;
+    HashMap<int, EmployeeNode*> m_employeeNodes;
+    
+    // AVL Tree for fast employee search by ID (stays balanced for ascending IDs)
+    AVLTree<Employee, int>* m_employeeAVL;
+    
+    // Indexed heap for pending leave requests (FIFO by default, reorderable)
+    IndexedHeap<LeaveRequest> m_pendingLeaveHeap;
+    PendingLeaveOrder m_pendingLeaveOrder;
+    
+    // Doubly Linked List for all leave requests
+    DoublyLinkedList<LeaveRequest> m_allLeaveRequests;
+    
+    // Hash index over leave requests; the first request with a key wins
+    typedef DoublyLinkedList<LeaveRequest>::Node LeaveNode;
+    struct LeaveHandle {
+        LeaveNode* node;                            // Entry in m_allLeaveRequests
+        IndexedHeap<LeaveRequest>::Handle pending;  // Entry in m_pendingLeaveHeap, or -1
+    };
+    HashMap<quint64, LeaveHandle> m_leaveIndex;                         // Key: LeaveKey
+    HashMap<int, std::vector<LeaveNode*>> m_employeeLeaveRequests;     // Submission order
+    
+    // Interval trees over indexed leave requests (closed [start, end])
+    IntervalTree<LeaveNode*> m_approvedLeaveTree;             // Approved, by Julian day
+    IntervalTree<LeaveNode*, quint64> m_activeLeaveTree;      // Pending + approved, LeaveKey endpoints
+    
+    // B+ Tree for Attendance Records (by date), stored as 12-byte AttendanceEntry
+    BPlusTree<AttendanceEntry, quint64>* m_attendanceBPlusTree;   // Key: AttendanceKey (day, employeeId)
+    
+    // AVL Tree indexing the same records per employee, recent window only
+    AVLTree<AttendanceEntry, quint64>* m_employeeAttendanceAVL;   // Key: AttendanceKey::byEmployee (employeeId, day)
+    
+    // Per-employee records before m_attendanceArchiveDay, compressed
+    HashMap<int, AttendancePostings> m_attendanceHistory;
+    qint32 m_attendanceArchiveDay;                                // Julian day
+    static const int RecentAttendanceMonths = 3;                  // Kept in the AVL besides this month
+    
+    // Employee name as last recorded in attendance, for rebuilding AttendanceRecord
+    HashMap<int, StringPool::Id> m_attendanceNames;
+    
+    // Columnar copy of the B+ tree for aggregate reports; appends in key order
+    // are applied directly, anything else marks it stale until the next report
+    AttendanceColumns m_attendanceColumns;
+    bool m_attendanceColumnsStale;
+    
+    // Employee ID -> days with attendance, for present/absent counts
+    HashMap<int, PresenceBitmap> m_presence;
+    
+    // Persistence: the text files are base snapshots and every mutation is
+    // appended to the write-ahead log before it returns. A checkpoint writes
+    // new base files (attendance on a worker thread) and retires the log.
+    WriteAheadLog m_log;
+    bool m_loading;                     // Loading or replaying: nothing is logged
+    QFuture<void> m_checkpoint;
+    static const int CheckpointLogEntries = 10000;
+    QString m_saveError;                // Set while a change is in neither the log nor the base files
+    
+    // Delta-encoded undo/redo history, bounded by a byte budget
+    ActionLog m_undoLog;
+    ActionLog m_redoLog;
+    
+    static DataManager* instance;
+    
+    // Move a leave request between the interval trees to match its status
+    void indexLeaveIntervals(LeaveNode* node);
+    
+    // Record a new action for undo; clears the redo history
+    void pushUndoEntry(const ActionEntry& entry);
+    
+    // Rebuild the UI-facing record from a stored entry
+    AttendanceRecord toAttendanceRecord(const AttendanceEntry& entry) const;
+    
+    // Rebuild m_attendanceColumns from the B+ tree if it is stale: O(n)
+    void refreshAttendanceColumns();
+    
+    // Visit one employee's records on [firstDay, lastDay] in day order: archived
+    // history first, then the recent window in the AVL index
+    template<typename Visitor>
+    void visitEmployeeAttendance(int employeeId, qint32 firstDay, qint32 lastDay, Visitor&& visitor) const;
+    
+    // Append a mutation (first byte: its LogType) to the write-ahead log.
+    // If the log cannot be written, every base file is rewritten instead;
+    // if that fails too, the error is kept for getSaveError().
+    void logChange(const ActionEntry& entry);
+    
+    // Write all base files synchronously, stamped with the next sequence
+    // number, as they hold every change made so far
+    bool rewriteBaseFiles();
+    
+    // Copy of the attendance records and names for writing a base file
+    std::shared_ptr<AttendanceFile::Contents> snapshotAttendance(quint64 sequence) const;
+    
+    // Re-apply the logged mutations whose type bit is set in typeMask and
+    // whose sequence number is at least fromSequence, from the log a
+    // checkpoint is folding in and then the current one
+    void replayLog(quint32 typeMask, quint64 fromSequence);
+    void applyLogEntry(ActionEntry& entry);
+    
+    DataManager() : m_pendingLeaveOrder(PendingLeaveOrder::Submission), m_attendanceArchiveDay(0),
+                    m_attendanceColumnsStale(false), m_log("changes.wal"), m_loading(false) {
+        m_employeeAVL = new AVLTree<Employee, int>([](const Employee& e) { return e.getId(); });
+        m_attendanceBPlusTree = new BPlusTree<AttendanceEntry, quint64>([](const AttendanceEntry& e) {
+            return AttendanceKey::make(e);
+        });
+        m_employeeAttendanceAVL = new AVLTree<AttendanceEntry, quint64>([](const AttendanceEntry& e) {
+            return AttendanceKey::byEmployee(e);
+        });
+    }
+
+public:
+    static DataManager* getInstance() {
+        if (!instance) {
+            instance = new DataManager();
+        }
+        return instance;
+    }
+    
+    ~DataManager() {
+        m_checkpoint.waitForFinished();
+        delete m_employeeAVL;
+        delete m_attendanceBPlusTree;
+        delete m_employeeAttendanceAVL;
+    }
+    
+    // Employee Operations using Doubly Linked List + AVL Tree
+    void addEmployee(const Employee& emp, bool recordAction = true);
+    bool updateEmployee(int id, const Employee& emp, bool recordAction = true);
+    bool deleteEmployee(int id, bool recordAction = true);
+    Employee* findEmployee(int id);
+    QList<Employee> getAllEmployees();
+    int getEmployeeCount();
+    
+    // Read-only views (no copy); invalidated by any modification
+    RangeView<DoublyLinkedList<Employee>> employeesView() const;      // Insertion order
+    RangeView<AVLTree<Employee, int>> employeesByIdView() const;      // Ascending ID
+    
+    // Leave Request Operations using Indexed Heap + Hash Index
+    void submitLeaveRequest(const LeaveRequest& request);
+    LeaveRequest* getNextPendingRequest();
+    bool processLeaveRequest(int employeeId, const QDate& startDate, LeaveStatus newStatus, bool recordAction = true);
+    QList<LeaveRequest> getAllLeaveRequests();
+    QList<LeaveRequest> getPendingRequests();
+    QList<LeaveRequest> getEmployeeLeaveRequests(int employeeId);
+    RangeView<DoublyLinkedList<LeaveRequest>> leaveRequestsView() const;
+    
+    // Pending queue ordering; changing it reorders the heap in place
+    void setPendingLeaveOrder(PendingLeaveOrder order);
+    void setPendingLeaveKey(IndexedHeap<LeaveRequest>::KeyFunction key);  // Custom order
+    PendingLeaveOrder getPendingLeaveOrder();
+    QList<LeaveRequest> getTopPendingRequests(int count);   // O(count log count)
+    int getPendingCount();
+    
+    // Interval queries over leave: O(log n + k)
+    QList<LeaveRequest> getApprovedLeavesOn(const QDate& date);     // Who is off on a day
+    QList<LeaveRequest> getOverlappingLeaveRequests(int employeeId, const QDate& start,
+                                                    const QDate& end);  // Pending or approved
+    bool hasOverlappingLeave(int employeeId, const QDate& start, const QDate& end);
+    
+    // Attendance Operations using B+ Tree (by date) + AVL Tree (by employee)
+    // Records are stored as AttendanceEntry; these methods convert at the boundary
+    void addAttendanceRecord(const AttendanceRecord& record);
+    bool removeAttendanceRecord(int employeeId, const QDate& date);
+    bool findAttendanceRecord(int employeeId, const QDate& date, AttendanceRecord& record);
+    QList<AttendanceRecord> getAttendanceByDateRange(const QDate& start, const QDate& end);
+    QList<AttendanceRecord> getEmployeeAttendance(int employeeId);
+    QList<AttendanceRecord> getEmployeeAttendanceByDateRange(int employeeId, const QDate& start, const QDate& end);
+    int countEmployeeAttendance(int employeeId, const QDate& start, const QDate& end) const;  // Days present
+    void getPresenceCounts(int employeeId, const QDate& start, const QDate& end,
+                           int& present, int& absent) const;    // Absent = working days missed
+    bool getLatestAttendance(int employeeId, AttendanceRecord& record);
+    bool hasAttendanceToday(int employeeId);
+    RangeView<BPlusTree<AttendanceEntry, quint64>> attendanceView() const;   // By date
+    
+    // Aggregate reports: O(log n + k) over the k records in the range
+    AttendanceSummary summarizeAttendance(const QDate& start, const QDate& end);    // Company-wide, SIMD
+    QList<AttendanceSummary> summarizeAttendanceByEmployee(const QDate& start, const QDate& end);
+    AttendanceSummary summarizeEmployeeAttendance(int employeeId, const QDate& start, const QDate& end);
+    
+    // Compress per-employee history before day out of the AVL index: one
+    // eraseRange per employee, O(E log n + m) for E employees and m records.
+    // loadAttendanceRecords() archives everything before the recent months.
+    void archiveAttendanceBefore(const QDate& day);
+    QDate getAttendanceArchiveDate() const;
+    int getAttendanceHistoryMemory() const;     // Bytes in the compressed postings
+    
+    // Bulk jobs: the per-employee AVL index is changed by split/join and the
+    // date-ordered B+ tree by whole pages, rather than one rebalancing
+    // insert or remove per record
+    int purgeAttendance(const QDate& start, const QDate& end);   // Returns records removed
+    void importAttendanceRecords(const QList<AttendanceRecord>& records);
     
-    // Undo/Redo using Stack
+    // Undo/Redo using the delta-encoded action logs: O(1) per step
     bool undo();
     bool redo();
     bool canUndo();
     bool canRedo();
+    void setUndoBudget(int bytes);     // Applies to undo and redo history each
+    int getUndoBudget() const;
+    int getUndoMemoryUsage() const;    // Live bytes in both logs
     
-    // File Operations
+    // File Operations. Loading reads a base file, then replays the log on
+    // top. Changes are already logged, so saving only checkpoints once the
+    // log holds CheckpointLogEntries entries. The save functions return
+    // false while a change could not be written (see getSaveError()); each
+    // call retries by rewriting the base files.
     void loadAllData();
-    void saveAllData();
+    bool saveAllData();
     void loadEmployees();
-    void saveEmployees();
+    bool saveEmployees();
     void loadLeaveRequests();
-    void saveLeaveRequests();
+    bool saveLeaveRequests();
     void loadAttendanceRecords();
-    void saveAttendanceRecords();
+    bool saveAttendanceRecords();
+    void checkpoint();                // Write all base files now and retire the log
+    QString getSaveError() const;     // Empty when every change is on disk
+    bool hasEmployeeFiles() const;    // An employee base file or a log exists
     
     // Statistics
-    int getBSTHeight();
+    int getBSTHeight();     // Height of the employee ID search tree
     int getAVLHeight();
     bool isAVLBalanced();
+    int getBPlusTreeHeight();
 };
 
 #endif // DATASTRUCTURES_H
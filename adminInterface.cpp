@@ -11,7 +11,8 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QTimer>
-#include <QSet>
+#include <algorithm>
+#include <iterator>
 
 AdminInterface::AdminInterface(QWidget *parent)
     : QMainWindow(parent)
@@ -70,6 +71,7 @@ AdminInterface::AdminInterface(QWidget *parent)
     // Watch files for changes
     m_fileWatcher->addPath("employees.txt");
     m_fileWatcher->addPath("leave_requests.txt");
+    m_fileWatcher->addPath("changes.wal");
     m_fileWatcher->addPath("feedback.txt");
     connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, this, &AdminInterface::onFileChanged);
 
@@ -201,40 +203,11 @@ void AdminInterface::setupAttendanceChart()
 
 void AdminInterface::calculateAttendanceData(const QString& employeeId, int& present, int& absent)
 {
-    present = 0;
-    absent = 0;
-    
-    QFile file("attendance.txt");
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&file);
-        QDateTime currentDate = QDateTime::currentDateTime();
-        QSet<int> daysPresent;
-        
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            QStringList parts = line.split("|");  // File uses | delimiter
-            if (parts.size() >= 3 && parts[0] == employeeId) {
-                QDate attendanceDate = QDate::fromString(parts[2], "yyyy-MM-dd");
-                if (attendanceDate.month() == currentDate.date().month() &&
-                    attendanceDate.year() == currentDate.date().year()) {
-                    daysPresent.insert(attendanceDate.day());
-                }
-            }
-        }
-        file.close();
-        
-        present = daysPresent.size();
-        // Calculate working days in the current month up to today
-        int daysInMonth = qMin(currentDate.date().day(), currentDate.date().daysInMonth());
-        int workingDays = 0;
-        for (int d = 1; d <= daysInMonth; d++) {
-            QDate date(currentDate.date().year(), currentDate.date().month(), d);
-            if (date.dayOfWeek() <= 5) {  // Monday to Friday
-                workingDays++;
-            }
-        }
-        absent = qMax(0, workingDays - present);
-    }
+    // Presence bitmap popcounts for the current month up to today; absent
+    // counts Monday-to-Friday days without an attendance record
+    QDate today = QDate::currentDate();
+    QDate monthStart(today.year(), today.month(), 1);
+    m_dataManager->getPresenceCounts(employeeId.toInt(), monthStart, today, present, absent);
 }
 
 void AdminInterface::updateAttendanceChart(const QString& employeeId)
@@ -296,7 +269,22 @@ void AdminInterface::setupLeaveTab()
     buttonLayout->addWidget(m_rejectButton);
     buttonLayout->addStretch();
     
+    // Pending queue ordering (Indexed Heap) and the next requests in line
+    QHBoxLayout *queueLayout = new QHBoxLayout;
+    m_pendingOrderCombo = new QComboBox;
+    m_pendingOrderCombo->addItem("Submission order");
+    m_pendingOrderCombo->addItem("Start date (most urgent first)");
+    m_pendingQueueLabel = new QLabel;
+    m_onLeaveTodayLabel = new QLabel;
+    
+    queueLayout->addWidget(new QLabel("Order pending by:"));
+    queueLayout->addWidget(m_pendingOrderCombo);
+    queueLayout->addStretch();
+    
     layout->addWidget(titleLabel);
+    layout->addLayout(queueLayout);
+    layout->addWidget(m_pendingQueueLabel);
+    layout->addWidget(m_onLeaveTodayLabel);
     layout->addWidget(m_leaveTable);
     layout->addLayout(buttonLayout);
     
@@ -307,6 +295,8 @@ void AdminInterface::setupLeaveTab()
             this, &AdminInterface::approveLeaveRequest);
     connect(m_rejectButton, &QPushButton::clicked,
             this, &AdminInterface::rejectLeaveRequest);
+    connect(m_pendingOrderCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &AdminInterface::onPendingOrderChanged);
 }
 
 void AdminInterface::setupFeedbackTab()
@@ -464,14 +454,17 @@ void AdminInterface::setupStyles()
 
 void AdminInterface::loadEmployees()
 {
-    // Data is loaded via DataManager using Doubly Linked List + BST
+    // Data is loaded via DataManager using Doubly Linked List + AVL Tree
     m_dataManager->loadEmployees();
 }
 
 void AdminInterface::saveEmployees()
 {
-    // Save via DataManager (uses Doubly Linked List traversal)
-    m_dataManager->saveEmployees();
+    // Changes are already in the write-ahead log; DataManager reports a
+    // change it could not write anywhere
+    if (!m_dataManager->saveEmployees()) {
+        reportSaveError();
+    }
 }
 
 void AdminInterface::loadLeaveRequests()
@@ -482,8 +475,14 @@ void AdminInterface::loadLeaveRequests()
 
 void AdminInterface::saveLeaveRequests()
 {
-    // Save via DataManager (uses Doubly Linked List traversal)
-    m_dataManager->saveLeaveRequests();
+    if (!m_dataManager->saveLeaveRequests()) {
+        reportSaveError();
+    }
+}
+
+void AdminInterface::reportSaveError()
+{
+    QMessageBox::critical(this, "Save Error", m_dataManager->getSaveError());
 }
 
 void AdminInterface::loadFeedback()
@@ -506,18 +505,19 @@ void AdminInterface::refreshEmployeeList()
 {
     loadEmployees();
     
-    // Get employees from DataManager (stored in Doubly Linked List)
-    QList<Employee> employees = m_dataManager->getAllEmployees();
+    // Iterate the Doubly Linked List in place through a read-only view
+    auto employees = m_dataManager->employeesView();
     
     m_employeeTable->setRowCount(employees.size());
     
-    for (int i = 0; i < employees.size(); ++i) {
-        const Employee& emp = employees[i];
+    int i = 0;
+    for (const Employee& emp : employees) {
         m_employeeTable->setItem(i, 0, new QTableWidgetItem(QString::number(emp.getId())));
         m_employeeTable->setItem(i, 1, new QTableWidgetItem(emp.getName()));
         m_employeeTable->setItem(i, 2, new QTableWidgetItem(emp.getDepartment()));
         m_employeeTable->setItem(i, 3, new QTableWidgetItem(emp.getPosition()));
         m_employeeTable->setItem(i, 4, new QTableWidgetItem(QString::number(emp.getSalary(), 'f', 2)));
+        ++i;
     }
     
     clearEmployeeForm();
@@ -548,13 +548,15 @@ void AdminInterface::addEmployee()
         return;
     }
     
-    // Find next available ID using BST max operation
-    QList<Employee> employees = m_dataManager->getAllEmployees();
+    // Find next available ID (max over current employees)
+    auto employees = m_dataManager->employeesView();
+    auto maxEmp = std::max_element(employees.begin(), employees.end(),
+                                   [](const Employee& a, const Employee& b) {
+                                       return a.getId() < b.getId();
+                                   });
     int maxId = 1000;
-    for (const Employee& emp : employees) {
-        if (emp.getId() > maxId) {
-            maxId = emp.getId();
-        }
+    if (maxEmp != employees.end() && maxEmp->getId() > maxId) {
+        maxId = maxEmp->getId();
     }
     
     Employee newEmp(maxId + 1, 
@@ -567,9 +569,9 @@ void AdminInterface::addEmployee()
         newEmp.setPassword(m_empPasswordEdit->text());
     }
     
-    // Add employee using DataManager (stores in Doubly Linked List + BST)
+    // Add employee using DataManager (stores in Doubly Linked List + AVL Tree)
     m_dataManager->addEmployee(newEmp);
-    m_dataManager->saveEmployees();
+    saveEmployees();
     refreshEmployeeList();
     
     QMessageBox::information(this, "Success", "Employee added successfully!");
@@ -578,13 +580,16 @@ void AdminInterface::addEmployee()
 void AdminInterface::editEmployee()
 {
     int row = m_employeeTable->currentRow();
-    QList<Employee> employees = m_dataManager->getAllEmployees();
+    auto employees = m_dataManager->employeesView();
     
     if (row < 0 || row >= employees.size()) {
         QMessageBox::warning(this, "Selection Error", "Please select an employee to update.");
         return;
     }
     
+    // Copy the selected row's employee before the list is modified
+    const Employee selected = *std::next(employees.begin(), row);
+    
     // Validate required fields
     if (m_empNameEdit->text().trimmed().isEmpty()) {
         QMessageBox::warning(this, "Input Error", "Employee name cannot be empty.");
@@ -592,7 +597,7 @@ void AdminInterface::editEmployee()
         return;
     }
     
-    int empId = employees[row].getId();
+    int empId = selected.getId();
     
     Employee updatedEmp(empId,
                        m_empNameEdit->text().trimmed(),
@@ -603,12 +608,12 @@ void AdminInterface::editEmployee()
     if (!m_empPasswordEdit->text().isEmpty()) {
         updatedEmp.setPassword(m_empPasswordEdit->text());
     } else {
-        updatedEmp.setPassword(employees[row].getPassword());
+        updatedEmp.setPassword(selected.getPassword());
     }
     
-    // Update using DataManager (updates in both Doubly Linked List and BST)
+    // Update using DataManager (updates in both Doubly Linked List and AVL Tree)
     m_dataManager->updateEmployee(empId, updatedEmp);
-    m_dataManager->saveEmployees();
+    saveEmployees();
     refreshEmployeeList();
     
     QMessageBox::information(this, "Success", "Employee updated successfully!");
@@ -617,22 +622,23 @@ void AdminInterface::editEmployee()
 void AdminInterface::deleteEmployee()
 {
     int row = m_employeeTable->currentRow();
-    QList<Employee> employees = m_dataManager->getAllEmployees();
+    auto employees = m_dataManager->employeesView();
     
     if (row < 0 || row >= employees.size()) {
         QMessageBox::warning(this, "Selection Error", "Please select an employee to delete.");
         return;
     }
     
-    const Employee& emp = employees[row];
+    // Copy the selected row's employee before the list is modified
+    const Employee emp = *std::next(employees.begin(), row);
     int ret = QMessageBox::question(this, "Confirm Delete", 
                                    QString("Are you sure you want to delete employee %1?").arg(emp.getName()),
                                    QMessageBox::Yes | QMessageBox::No);
     
     if (ret == QMessageBox::Yes) {
-        // Delete using DataManager (removes from both Doubly Linked List and BST)
+        // Delete using DataManager (removes from both Doubly Linked List and AVL Tree)
         m_dataManager->deleteEmployee(emp.getId());
-        m_dataManager->saveEmployees();
+        saveEmployees();
         refreshEmployeeList();
         
         QMessageBox::information(this, "Success", "Employee deleted successfully!");
@@ -646,7 +652,7 @@ void AdminInterface::onEmployeeSelectionChanged()
         QString employeeId = selectedItems[0]->text(); // First column is ID
         updateAttendanceChart(employeeId);
         
-        // Populate form using BST search (O(log n))
+        // Populate form using AVL search (O(log n))
         int id = employeeId.toInt();
         Employee* emp = m_dataManager->findEmployee(id);
         if (emp) {
@@ -679,13 +685,13 @@ void AdminInterface::refreshLeaveRequests()
 {
     loadLeaveRequests();
     
-    // Get all leave requests from DataManager (stored in Doubly Linked List)
-    QList<LeaveRequest> leaveRequests = m_dataManager->getAllLeaveRequests();
+    // Iterate the Doubly Linked List in place through a read-only view
+    auto leaveRequests = m_dataManager->leaveRequestsView();
     
     m_leaveTable->setRowCount(leaveRequests.size());
     
-    for (int i = 0; i < leaveRequests.size(); ++i) {
-        const LeaveRequest& request = leaveRequests[i];
+    int i = 0;
+    for (const LeaveRequest& request : leaveRequests) {
         m_leaveTable->setItem(i, 0, new QTableWidgetItem(QString::number(request.getEmployeeId())));
         m_leaveTable->setItem(i, 1, new QTableWidgetItem(request.getEmployeeName()));
         m_leaveTable->setItem(i, 2, new QTableWidgetItem(request.getStartDate().toString("yyyy-MM-dd")));
@@ -701,26 +707,71 @@ void AdminInterface::refreshLeaveRequests()
             statusItem->setBackground(QBrush(QColor(241, 196, 15, 100)));
         }
         m_leaveTable->setItem(i, 5, statusItem);
+        ++i;
+    }
+    
+    refreshPendingQueue();
+    
+    // Approved leave covering today (Interval Tree stabbing query)
+    const QList<LeaveRequest> onLeave = m_dataManager->getApprovedLeavesOn(QDate::currentDate());
+    QStringList names;
+    for (const LeaveRequest& request : onLeave) {
+        names << request.getEmployeeName();
     }
+    m_onLeaveTodayLabel->setText(names.isEmpty() ? QString("Nobody is on approved leave today.")
+                                                 : QString("On leave today: %1").arg(names.join(", ")));
     
     // Update undo/redo button states
     m_undoButton->setEnabled(m_dataManager->canUndo());
     m_redoButton->setEnabled(m_dataManager->canRedo());
 }
 
+void AdminInterface::refreshPendingQueue()
+{
+    // Only the top of the Indexed Heap is read; the queue is not copied
+    const int shown = 5;
+    QList<LeaveRequest> next = m_dataManager->getTopPendingRequests(shown);
+    
+    if (next.isEmpty()) {
+        m_pendingQueueLabel->setText("No pending leave requests.");
+        return;
+    }
+    
+    QStringList lines;
+    for (const LeaveRequest& request : next) {
+        lines << QString("%1 (ID %2): %3 to %4")
+                     .arg(request.getEmployeeName())
+                     .arg(request.getEmployeeId())
+                     .arg(request.getStartDate().toString("yyyy-MM-dd"))
+                     .arg(request.getEndDate().toString("yyyy-MM-dd"));
+    }
+    m_pendingQueueLabel->setText(QString("Next up (%1 pending):\n%2")
+                                     .arg(m_dataManager->getPendingCount())
+                                     .arg(lines.join("\n")));
+}
+
+void AdminInterface::onPendingOrderChanged(int index)
+{
+    // Reorders the heap in place; the requests themselves are not reloaded
+    m_dataManager->setPendingLeaveOrder(index == 1 ? PendingLeaveOrder::StartDate
+                                                   : PendingLeaveOrder::Submission);
+    refreshPendingQueue();
+}
+
 void AdminInterface::approveLeaveRequest()
 {
     int row = m_leaveTable->currentRow();
-    QList<LeaveRequest> leaveRequests = m_dataManager->getAllLeaveRequests();
+    auto leaveRequests = m_dataManager->leaveRequestsView();
     
     if (row >= 0 && row < leaveRequests.size()) {
-        const LeaveRequest& request = leaveRequests[row];
+        // Copy the selected request before the list is modified
+        const LeaveRequest request = *std::next(leaveRequests.begin(), row);
         
-        // Process leave request using DataManager (uses Queue for FIFO processing)
+        // Process leave request using DataManager (removes it from the pending Indexed Heap)
         m_dataManager->processLeaveRequest(request.getEmployeeId(), 
                                            request.getStartDate(), 
                                            LeaveStatus::Approved);
-        m_dataManager->saveLeaveRequests();
+        saveLeaveRequests();
         refreshLeaveRequests();
         
         QMessageBox::information(this, "Success", "Leave request approved!");
@@ -730,16 +781,17 @@ void AdminInterface::approveLeaveRequest()
 void AdminInterface::rejectLeaveRequest()
 {
     int row = m_leaveTable->currentRow();
-    QList<LeaveRequest> leaveRequests = m_dataManager->getAllLeaveRequests();
+    auto leaveRequests = m_dataManager->leaveRequestsView();
     
     if (row >= 0 && row < leaveRequests.size()) {
-        const LeaveRequest& request = leaveRequests[row];
+        // Copy the selected request before the list is modified
+        const LeaveRequest request = *std::next(leaveRequests.begin(), row);
         
         // Process leave request using DataManager
         m_dataManager->processLeaveRequest(request.getEmployeeId(), 
                                            request.getStartDate(), 
                                            LeaveStatus::Rejected);
-        m_dataManager->saveLeaveRequests();
+        saveLeaveRequests();
         refreshLeaveRequests();
         
         QMessageBox::information(this, "Success", "Leave request rejected.");
@@ -749,10 +801,11 @@ void AdminInterface::rejectLeaveRequest()
 void AdminInterface::onLeaveRequestSelectionChanged()
 {
     int row = m_leaveTable->currentRow();
-    QList<LeaveRequest> leaveRequests = m_dataManager->getAllLeaveRequests();
+    auto leaveRequests = m_dataManager->leaveRequestsView();
     
     bool hasSelection = (row >= 0 && row < leaveRequests.size());
-    bool isPending = hasSelection && leaveRequests[row].getStatus() == LeaveStatus::Pending;
+    bool isPending = hasSelection &&
+                     std::next(leaveRequests.begin(), row)->getStatus() == LeaveStatus::Pending;
     
     m_approveButton->setEnabled(isPending);
     m_rejectButton->setEnabled(isPending);
@@ -779,8 +832,9 @@ void AdminInterface::onFileChanged(const QString& path)
     // Re-add the file to the watcher as it might have been recreated
     m_fileWatcher->addPath(path);
     
-    // Auto-refresh leave requests and feedback when their files change
-    if (path.endsWith("leave_requests.txt")) {
+    // Auto-refresh leave requests and feedback when their files change; leave
+    // changes land in the write-ahead log first
+    if (path.endsWith("leave_requests.txt") || path.endsWith("changes.wal")) {
         loadLeaveRequests();
         refreshLeaveRequests();
         
@@ -810,7 +864,9 @@ void AdminInterface::updateDateTime()
 void AdminInterface::undoAction()
 {
     if (m_dataManager->undo()) {
-        m_dataManager->saveAllData();
+        if (!m_dataManager->saveAllData()) {
+            reportSaveError();
+        }
         refreshEmployeeList();
         refreshLeaveRequests();
         
@@ -823,7 +879,9 @@ void AdminInterface::undoAction()
 void AdminInterface::redoAction()
 {
     if (m_dataManager->redo()) {
-        m_dataManager->saveAllData();
+        if (!m_dataManager->saveAllData()) {
+            reportSaveError();
+        }
         refreshEmployeeList();
         refreshLeaveRequests();
         
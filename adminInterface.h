@@ -16,6 +16,7 @@
 #include <QFileSystemWatcher>
 #include <QTextEdit>
 #include <QTabWidget>
+#include <QComboBox>
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
 #include <QtCharts/QPieSeries>
@@ -52,6 +53,7 @@ private slots:
     void deleteEmployee();
     void approveLeaveRequest();
     void rejectLeaveRequest();
+    void onPendingOrderChanged(int index);
     void logout();
     // DSA Operations
     void undoAction();
@@ -72,9 +74,11 @@ private:
     void saveEmployees();
     void loadLeaveRequests();
     void saveLeaveRequests();
+    void reportSaveError();
     void loadFeedback();
     void refreshEmployeeList();
     void refreshLeaveRequests();
+    void refreshPendingQueue();
     void refreshFeedback();
 
 private:
@@ -108,6 +112,9 @@ private:
     QTableWidget* m_leaveTable;
     QPushButton* m_approveButton;
     QPushButton* m_rejectButton;
+    QComboBox* m_pendingOrderCombo;
+    QLabel* m_pendingQueueLabel;
+    QLabel* m_onLeaveTodayLabel;
 
     // Feedback tab elements
     QTextEdit* m_feedbackDisplay;
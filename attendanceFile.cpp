@@ -0,0 +1,172 @@
+#include "attendanceFile.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QtEndian>
+#include <cstddef>
+#include <cstring>
+
+static const char Magic[4] = { 'E', 'A', 'S', 'A' };
+static const int HeaderSize = 24;
+static const int RecordSize = 12;
+static const QString CheckpointTag("#checkpoint|");
+
+// Lets a little-endian host copy the record section straight into entries
+static_assert(offsetof(AttendanceEntry, day) == 4 && offsetof(AttendanceEntry, timeIn) == 8 &&
+              offsetof(AttendanceEntry, timeOut) == 10 && sizeof(AttendanceEntry) == RecordSize,
+              "AttendanceEntry must match the binary record layout");
+
+QString AttendanceFile::checkpointLine(quint64 sequence)
+{
+    return CheckpointTag + QString::number(sequence);
+}
+
+bool AttendanceFile::readCheckpointLine(const QString& line, quint64& sequence)
+{
+    if (!line.startsWith(CheckpointTag)) return false;
+    sequence = line.mid(CheckpointTag.size()).toULongLong();
+    return true;
+}
+
+bool AttendanceFile::readBinary(const QString& fileName, Contents& contents)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < HeaderSize) return false;
+    qint64 size = file.size();
+    uchar* data = file.map(0, size);
+    if (!data) return false;
+
+    quint16 version = qFromLittleEndian<quint16>(data + 4);
+    quint16 recordSize = qFromLittleEndian<quint16>(data + 6);
+    quint32 count = qFromLittleEndian<quint32>(data + 16);
+    quint32 nameCount = qFromLittleEndian<quint32>(data + 20);
+    qint64 namesOffset = HeaderSize + qint64(count) * recordSize;
+    bool valid = memcmp(data, Magic, sizeof(Magic)) == 0 && version >= 1 && version <= Version &&
+                 recordSize >= RecordSize && namesOffset <= size;
+
+    if (valid) {
+        contents.sequence = qFromLittleEndian<quint64>(data + 8);
+        contents.entries.resize(count);
+        const uchar* record = data + HeaderSize;
+        if (Q_BYTE_ORDER == Q_LITTLE_ENDIAN && recordSize == RecordSize && count > 0) {
+            memcpy(contents.entries.data(), record, size_t(count) * RecordSize);
+        } else {
+            for (quint32 i = 0; i < count; ++i, record += recordSize) {
+                AttendanceEntry& entry = contents.entries[i];
+                entry.employeeId = qFromLittleEndian<qint32>(record);
+                entry.day = qFromLittleEndian<qint32>(record + 4);
+                entry.timeIn = qFromLittleEndian<quint16>(record + 8);
+                entry.timeOut = qFromLittleEndian<quint16>(record + 10);
+            }
+        }
+
+        const uchar* name = data + namesOffset;
+        const uchar* end = data + size;
+        for (quint32 i = 0; i < nameCount && valid; ++i) {
+            quint32 length = end - name >= 8 ? qFromLittleEndian<quint32>(name + 4) : 0;
+            valid = end - name >= 8 && quint64(end - name - 8) >= length;
+            if (valid) {
+                contents.names.insert(qFromLittleEndian<qint32>(name),
+                                      QString::fromUtf8(reinterpret_cast<const char*>(name + 8), int(length)));
+                name += 8 + length;
+            }
+        }
+    }
+
+    file.unmap(data);
+    return valid;
+}
+
+bool AttendanceFile::readText(const QString& fileName, Contents& contents)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return false;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        if (line.isEmpty() || readCheckpointLine(line, contents.sequence)) continue;
+
+        AttendanceRecord record = AttendanceRecord::fromFileString(line);
+        if (record.getEmployeeId() > 0) {
+            contents.entries.push_back(record.toEntry());
+            contents.names.insert(record.getEmployeeId(), record.getEmployeeName());
+        }
+    }
+    return true;
+}
+
+bool AttendanceFile::writeBinary(const QString& fileName, const Contents& contents)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    char header[HeaderSize];
+    memcpy(header, Magic, sizeof(Magic));
+    qToLittleEndian<quint16>(Version, header + 4);
+    qToLittleEndian<quint16>(RecordSize, header + 6);
+    qToLittleEndian<quint64>(contents.sequence, header + 8);
+    qToLittleEndian<quint32>(quint32(contents.entries.size()), header + 16);
+    qToLittleEndian<quint32>(quint32(contents.names.size()), header + 20);
+    file.write(header, HeaderSize);
+
+    if (Q_BYTE_ORDER == Q_LITTLE_ENDIAN && !contents.entries.empty()) {
+        file.write(reinterpret_cast<const char*>(contents.entries.data()),
+                   qint64(contents.entries.size()) * RecordSize);
+    } else {
+        char record[RecordSize];
+        for (const AttendanceEntry& entry : contents.entries) {
+            qToLittleEndian<qint32>(entry.employeeId, record);
+            qToLittleEndian<qint32>(entry.day, record + 4);
+            qToLittleEndian<quint16>(entry.timeIn, record + 8);
+            qToLittleEndian<quint16>(entry.timeOut, record + 10);
+            file.write(record, RecordSize);
+        }
+    }
+
+    for (QHash<int, QString>::const_iterator it = contents.names.constBegin(); it != contents.names.constEnd(); ++it) {
+        QByteArray utf8 = it.value().toUtf8();
+        char prefix[8];
+        qToLittleEndian<qint32>(it.key(), prefix);
+        qToLittleEndian<quint32>(quint32(utf8.size()), prefix + 4);
+        file.write(prefix, sizeof(prefix));
+        file.write(utf8);
+    }
+    return file.commit();
+}
+
+bool AttendanceFile::writeText(const QString& fileName, const Contents& contents)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+
+    QTextStream out(&file);
+    out << checkpointLine(contents.sequence) << "\n";
+    for (const AttendanceEntry& entry : contents.entries) {
+        out << AttendanceRecord::toFileString(entry, contents.names.value(entry.employeeId)) << "\n";
+    }
+    out.flush();
+    return file.commit();
+}
+
+bool AttendanceFile::convert(const QString& source, const QString& target, QString& error)
+{
+    QFile file(source);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QString("Cannot open %1").arg(source);
+        return false;
+    }
+    bool binary = file.read(sizeof(Magic)) == QByteArray(Magic, sizeof(Magic));
+    file.close();
+
+    Contents contents;
+    if (binary ? !readBinary(source, contents) : !readText(source, contents)) {
+        error = QString("%1 is not a readable attendance file").arg(source);
+        return false;
+    }
+    if (binary ? !writeText(target, contents) : !writeBinary(target, contents)) {
+        error = QString("Cannot write %1").arg(target);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,56 @@
+#ifndef ATTENDANCEFILE_H
+#define ATTENDANCEFILE_H
+
+#include <QString>
+#include <QHash>
+#include <vector>
+#include "attendanceRecord.h"
+
+// ============================================================================
+// ATTENDANCE FILE - Binary and text formats of the attendance base file
+// ============================================================================
+// The binary file is memory-mapped and copied out without parsing. All
+// fields are little-endian:
+//     Header  char magic[4] "EASA" | quint16 version | quint16 recordSize
+//             quint64 checkpoint sequence | quint32 recordCount | quint32 nameCount
+//     Records recordCount x { qint32 employeeId | qint32 julianDay
+//                             quint16 timeIn | quint16 timeOut }
+//     Names   nameCount x { qint32 employeeId | quint32 length | UTF-8 bytes }
+// Times are minutes since midnight, 0xFFFF when not recorded. A later
+// version may append fields to a record: readers step by recordSize and
+// read the fields they know.
+// The text file is the older format: an optional "#checkpoint|<sequence>"
+// line, then one AttendanceRecord::toFileString() line per record.
+
+class AttendanceFile {
+public:
+    static const quint16 Version = 1;
+
+    // A whole base file: the records, each employee's name, and the
+    // write-ahead log sequence of the first change it does not include
+    struct Contents {
+        std::vector<AttendanceEntry> entries;
+        QHash<int, QString> names;
+        quint64 sequence;
+
+        Contents() : sequence(0) {}
+    };
+
+    // Both return false if the file is missing or not in that format
+    static bool readBinary(const QString& fileName, Contents& contents);
+    static bool readText(const QString& fileName, Contents& contents);
+
+    // Replace the file in one rename (QSaveFile)
+    static bool writeBinary(const QString& fileName, const Contents& contents);
+    static bool writeText(const QString& fileName, const Contents& contents);
+
+    // Reads either format and writes the other one; on failure returns false
+    // and describes why in error
+    static bool convert(const QString& source, const QString& target, QString& error);
+
+    // The "#checkpoint|<sequence>" first line every text base file starts with
+    static QString checkpointLine(quint64 sequence);
+    static bool readCheckpointLine(const QString& line, quint64& sequence);
+};
+
+#endif // ATTENDANCEFILE_H
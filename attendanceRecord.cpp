@@ -2,14 +2,14 @@
 #include <QStringList>
 
 AttendanceRecord::AttendanceRecord()
-    : m_employeeId(0)
+    : m_employeeId(0), m_employeeName(0)
 {
 }
 
 AttendanceRecord::AttendanceRecord(int employeeId, const QString& employeeName, 
                                   const QDate& date, const QTime& timeIn, 
                                   const QTime& timeOut)
-    : m_employeeId(employeeId), m_employeeName(employeeName),
+    : m_employeeId(employeeId), m_employeeName(StringPool::getInstance().intern(employeeName)),
       m_date(date), m_timeIn(timeIn), m_timeOut(timeOut)
 {
 }
@@ -18,19 +18,29 @@ QString AttendanceRecord::toFileString() const
 {
     return QString("%1|%2|%3|%4|%5")
            .arg(m_employeeId)
-           .arg(m_employeeName)
+           .arg(getEmployeeName())
            .arg(m_date.toString("yyyy-MM-dd"))
            .arg(m_timeIn.toString("hh:mm"))
            .arg(m_timeOut.isValid() ? m_timeOut.toString("hh:mm") : "");
 }
 
+QString AttendanceRecord::toFileString(const AttendanceEntry& entry, const QString& employeeName)
+{
+    return QString("%1|%2|%3|%4|%5")
+           .arg(entry.employeeId)
+           .arg(employeeName)
+           .arg(entry.getDate().toString("yyyy-MM-dd"))
+           .arg(entry.getTimeIn().toString("hh:mm"))
+           .arg(entry.isComplete() ? entry.getTimeOut().toString("hh:mm") : "");
+}
+
 AttendanceRecord AttendanceRecord::fromFileString(const QString& line)
 {
     QStringList parts = line.split('|');
     if (parts.size() >= 4) {
         AttendanceRecord record;
         record.m_employeeId = parts[0].toInt();
-        record.m_employeeName = parts[1];
+        record.m_employeeName = StringPool::getInstance().intern(parts[1]);
         record.m_date = QDate::fromString(parts[2], "yyyy-MM-dd");
         record.m_timeIn = QTime::fromString(parts[3], "hh:mm");
         if (parts.size() > 4 && !parts[4].isEmpty()) {
@@ -40,3 +50,24 @@ AttendanceRecord AttendanceRecord::fromFileString(const QString& line)
     }
     return AttendanceRecord();
 }
+
+AttendanceEntry AttendanceRecord::toEntry() const
+{
+    AttendanceEntry entry;
+    entry.employeeId = m_employeeId;
+    entry.day = static_cast<qint32>(m_date.toJulianDay());
+    entry.timeIn = AttendanceEntry::toMinutes(m_timeIn);
+    entry.timeOut = AttendanceEntry::toMinutes(m_timeOut);
+    return entry;
+}
+
+AttendanceRecord AttendanceRecord::fromEntry(const AttendanceEntry& entry, StringPool::Id employeeName)
+{
+    AttendanceRecord record;
+    record.m_employeeId = entry.employeeId;
+    record.m_employeeName = employeeName;
+    record.m_date = entry.getDate();
+    record.m_timeIn = entry.getTimeIn();
+    record.m_timeOut = entry.getTimeOut();
+    return record;
+}
@@ -4,7 +4,37 @@
 #include <QString>
 #include <QDate>
 #include <QTime>
+#include <type_traits>
+#include "stringPool.h"
 
+// Compact, trivially copyable form used by the in-memory attendance store:
+// 12 bytes per record instead of a QDate and two QTimes.
+struct AttendanceEntry
+{
+    static const quint16 NoTime = 0xFFFF;   // Time not recorded
+
+    qint32 employeeId;
+    qint32 day;         // Julian day number
+    quint16 timeIn;     // Minutes since midnight, or NoTime
+    quint16 timeOut;
+
+    QDate getDate() const { return QDate::fromJulianDay(day); }
+    QTime getTimeIn() const { return fromMinutes(timeIn); }
+    QTime getTimeOut() const { return fromMinutes(timeOut); }
+    bool isComplete() const { return timeOut != NoTime; }
+
+    static quint16 toMinutes(const QTime& time) {
+        return time.isValid() ? static_cast<quint16>(time.hour() * 60 + time.minute()) : NoTime;
+    }
+    static QTime fromMinutes(quint16 minutes) {
+        return minutes == NoTime ? QTime() : QTime(minutes / 60, minutes % 60);
+    }
+};
+
+static_assert(std::is_trivially_copyable<AttendanceEntry>::value, "AttendanceEntry must stay POD");
+static_assert(sizeof(AttendanceEntry) == 12, "AttendanceEntry must stay 12 bytes");
+
+// Full record handed to the UI and used for file I/O
 class AttendanceRecord
 {
 public:
@@ -15,7 +45,8 @@ public:
 
     // Getters
     int getEmployeeId() const { return m_employeeId; }
-    QString getEmployeeName() const { return m_employeeName; }
+    QString getEmployeeName() const { return StringPool::getInstance().get(m_employeeName); }
+    StringPool::Id getEmployeeNameId() const { return m_employeeName; }
     QDate getDate() const { return m_date; }
     QTime getTimeIn() const { return m_timeIn; }
     QTime getTimeOut() const { return m_timeOut; }
@@ -28,9 +59,17 @@ public:
     QString toFileString() const;
     static AttendanceRecord fromFileString(const QString& line);
 
+    // Same line for a stored entry; touches no StringPool, so it is safe
+    // to call off the thread that owns the data
+    static QString toFileString(const AttendanceEntry& entry, const QString& employeeName);
+
+    // Conversion to and from the store's compact form; seconds are dropped
+    AttendanceEntry toEntry() const;
+    static AttendanceRecord fromEntry(const AttendanceEntry& entry, StringPool::Id employeeName);
+
 private:
     int m_employeeId;
-    QString m_employeeName;
+    StringPool::Id m_employeeName;  // Id into the StringPool
     QDate m_date;
     QTime m_timeIn;
     QTime m_timeOut;
@@ -0,0 +1,12 @@
+# Benchmarks for the containers in DataStructures.h, one console program
+# each. Build them in release mode for meaningful numbers:
+#   qmake bench/bench.pro CONFIG+=release && make
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    bplustree \
+    bulkjobs \
+    leaveindex \
+    nodepool \
+    ringbuffer \
+    visitors
@@ -0,0 +1,66 @@
+// B+ tree vs AVL tree as the date-ordered attendance store: bulk insert in
+// load order, random point lookups and one-month company-wide range scans.
+//   bench_bplustree [records...]     (default: 1000000 10000000)
+#include "DataStructures.h"
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static const int Lookups = 1000000;
+static const int MonthScans = 20;
+
+template<typename Tree>
+static void run(const char* name, int records)
+{
+    const int employees = records >= 10000000 ? 5000 : 1000;
+    const int days = records / employees;
+    const qint32 firstDay = qint32(QDate(2015, 1, 1).toJulianDay());
+
+    Tree tree([](const AttendanceEntry& entry) { return AttendanceKey::make(entry); });
+    QElapsedTimer timer;
+
+    // Insert one day at a time, the order records are clocked in
+    timer.start();
+    for (int day = 0; day < days; day++) {
+        for (int e = 0; e < employees; e++) {
+            AttendanceEntry entry = { 1000 + e, firstDay + day, 540, AttendanceEntry::NoTime };
+            tree.insert(entry);
+        }
+    }
+    double insertMs = timer.nsecsElapsed() / 1e6;
+
+    std::mt19937 random(7);
+    long hits = 0;
+    timer.start();
+    for (int i = 0; i < Lookups; i++) {
+        QDate date = QDate::fromJulianDay(firstDay + qint64(random() % days));
+        if (tree.search(AttendanceKey::make(date, 1000 + int(random() % employees)))) hits++;
+    }
+    double lookupMs = timer.nsecsElapsed() / 1e6;
+
+    long scanned = 0;
+    timer.start();
+    for (int i = 0; i < MonthScans; i++) {
+        QDate first = QDate::fromJulianDay(firstDay + qint64(random() % (days - 31)));
+        tree.rangeSearch(AttendanceKey::lowerBound(first), AttendanceKey::upperBound(first.addDays(29)),
+                         [&scanned](const AttendanceEntry&) { scanned++; });
+    }
+    double scanMs = timer.nsecsElapsed() / 1e6 / MonthScans;
+
+    std::printf("%-7s %9d records | insert %8.0f ms | %d lookups %6.0f ms (%ld hits) | month scan %7.2f ms (%ld records)\n",
+                name, records, insertMs, Lookups, lookupMs, hits, scanMs, scanned / MonthScans);
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<int> sizes;
+    for (int i = 1; i < argc; i++) sizes.push_back(std::atoi(argv[i]));
+    if (sizes.empty()) sizes = { 1000000, 10000000 };
+
+    for (int records : sizes) {
+        run<AVLTree<AttendanceEntry, quint64>>("AVL", records);
+        run<BPlusTree<AttendanceEntry, quint64>>("B+ tree", records);
+    }
+    return 0;
+}
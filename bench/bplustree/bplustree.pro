@@ -0,0 +1,5 @@
+include(../bench.pri)
+
+TARGET = bench_bplustree
+
+SOURCES += bench_bplustree.cpp
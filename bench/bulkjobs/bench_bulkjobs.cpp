@@ -0,0 +1,110 @@
+// Attendance purge and import: per-key insert/remove vs eraseRange and
+// unionWith on the AVL tree and the B+ tree, then the whole DataManager job
+// (both indexes, presence bitmaps and the log entry) on a scratch directory.
+//   bench_bulkjobs [records]     (default: 1000000)
+#include "DataStructures.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+static const int Employees = 1000;
+static const int Batch = 100000;
+
+template<typename Tree>
+static void runTree(const char* name, const std::vector<AttendanceEntry>& all, int days, qint32 firstDay)
+{
+    auto key = [](const AttendanceEntry& entry) { return AttendanceKey::make(entry); };
+    QElapsedTimer timer;
+
+    for (int span : { 30, 300 }) {
+        Tree perKey(key), bulk(key);
+        perKey.bulkLoad(all);
+        bulk.bulkLoad(all);
+        QDate first = QDate::fromJulianDay(firstDay + days / 10);
+        quint64 low = AttendanceKey::lowerBound(first);
+        quint64 high = AttendanceKey::upperBound(first.addDays(span - 1));
+        std::vector<quint64> keys;
+        perKey.rangeSearch(low, high, [&keys, &key](const AttendanceEntry& entry) { keys.push_back(key(entry)); });
+
+        timer.start();
+        for (quint64 k : keys) perKey.remove(k);
+        double perKeyMs = timer.nsecsElapsed() / 1e6;
+        timer.start();
+        bulk.eraseRange(low, high);
+        double bulkMs = timer.nsecsElapsed() / 1e6;
+        std::printf("%-7s purge %3d days (%7zu keys) | per-key %8.2f ms | eraseRange %8.2f ms\n",
+                    name, span, keys.size(), perKeyMs, bulkMs);
+    }
+
+    // Scattered: new employees across every day, in random order. Clustered:
+    // every employee for the days after the last one.
+    std::vector<AttendanceEntry> scattered, clustered;
+    for (int i = 0; i < Batch; i++) {
+        scattered.push_back(AttendanceEntry{ Employees + 1 + i % 100, firstDay + (i / 100) % days, 540, 1020 });
+        clustered.push_back(AttendanceEntry{ 1 + i % Employees, firstDay + days + i / Employees, 540, 1020 });
+    }
+    std::mt19937 random(7);
+    std::shuffle(scattered.begin(), scattered.end(), random);
+
+    for (const std::vector<AttendanceEntry>* batch : { &scattered, &clustered }) {
+        Tree perKey(key), bulk(key);
+        perKey.bulkLoad(all);
+        bulk.bulkLoad(all);
+        timer.start();
+        for (const AttendanceEntry& entry : *batch) perKey.insert(entry);
+        double perKeyMs = timer.nsecsElapsed() / 1e6;
+        timer.start();
+        bulk.unionWith(*batch);
+        double bulkMs = timer.nsecsElapsed() / 1e6;
+        std::printf("%-7s import %dk %-9s          | per-key %8.2f ms | unionWith  %8.2f ms\n",
+                    name, Batch / 1000, batch == &scattered ? "scattered" : "clustered", perKeyMs, bulkMs);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int records = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int days = records / Employees;
+    const qint32 firstDay = qint32(QDate(2015, 1, 1).toJulianDay());
+
+    std::vector<AttendanceEntry> all;
+    for (int day = 0; day < days; day++) {
+        for (int e = 1; e <= Employees; e++) {
+            all.push_back(AttendanceEntry{ e, firstDay + day, 540, 1020 });
+        }
+    }
+    runTree<AVLTree<AttendanceEntry, quint64>>("AVL", all, days, firstDay);
+    runTree<BPlusTree<AttendanceEntry, quint64>>("B+ tree", all, days, firstDay);
+
+    QTemporaryDir dataDir;
+    QDir::setCurrent(dataDir.path());
+    DataManager* dataManager = DataManager::getInstance();
+    QList<AttendanceRecord> existing;
+    for (const AttendanceEntry& entry : all) {
+        existing.append(AttendanceRecord(entry.employeeId, "Employee", entry.getDate(), QTime(9, 0), QTime(17, 0)));
+    }
+    dataManager->importAttendanceRecords(existing);
+
+    QList<AttendanceRecord> scattered;
+    for (int i = 0; i < Batch; i++) {
+        scattered.append(AttendanceRecord(Employees + 1 + i % 100, "New Employee",
+                                          QDate::fromJulianDay(firstDay + (i / 100) % days), QTime(9, 0), QTime(17, 0)));
+    }
+    std::mt19937 random(7);
+    std::shuffle(scattered.begin(), scattered.end(), random);
+
+    QElapsedTimer timer;
+    timer.start();
+    dataManager->importAttendanceRecords(scattered);
+    std::printf("DataManager import %dk scattered into %d records: %.1f ms\n", Batch / 1000, records, timer.nsecsElapsed() / 1e6);
+
+    QDate first = QDate::fromJulianDay(firstDay + days / 2);
+    timer.start();
+    int purged = dataManager->purgeAttendance(first, first.addDays(29));
+    std::printf("DataManager purge 30 days (%d records): %.1f ms\n", purged, timer.nsecsElapsed() / 1e6);
+    return 0;
+}
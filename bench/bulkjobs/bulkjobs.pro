@@ -0,0 +1,5 @@
+include(../bench.pri)
+
+TARGET = bench_bulkjobs
+
+SOURCES += bench_bulkjobs.cpp
@@ -0,0 +1,49 @@
+// Approving a backlog of queued leave requests through DataManager, then
+// listing each employee's requests. Runs in a temporary directory, since
+// every approval is written to the change log.
+//   bench_leaveindex [requests]     (default: 50000)
+#include "DataStructures.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <cstdio>
+#include <cstdlib>
+
+static const int Employees = 5000;
+
+int main(int argc, char* argv[])
+{
+    const int requests = argc > 1 ? std::atoi(argv[1]) : 50000;
+
+    QTemporaryDir dataDir;
+    if (!dataDir.isValid() || !QDir::setCurrent(dataDir.path())) {
+        std::fprintf(stderr, "Cannot create a temporary data directory\n");
+        return 1;
+    }
+
+    DataManager* dataManager = DataManager::getInstance();
+    const QDate firstDay(2024, 1, 1);
+    for (int i = 0; i < requests; i++) {
+        QDate start = firstDay.addDays(i / Employees);
+        dataManager->submitLeaveRequest(LeaveRequest(1001 + i % Employees, "Employee Name", start, start.addDays(1), "Vacation"));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < requests; i++) {
+        dataManager->processLeaveRequest(1001 + i % Employees, firstDay.addDays(i / Employees), LeaveStatus::Approved, false);
+    }
+    double approveMs = timer.nsecsElapsed() / 1e6;
+
+    long listed = 0;
+    timer.start();
+    for (int e = 0; e < Employees; e++) {
+        listed += dataManager->getEmployeeLeaveRequests(1001 + e).size();
+    }
+    double listMs = timer.nsecsElapsed() / 1e6;
+
+    std::printf("%d requests | approve all %8.1f ms (%.2f us each) | list %d employees %6.1f ms (%ld requests) | pending left %d\n",
+                requests, approveMs, approveMs * 1000 / requests, Employees, listMs, listed,
+                int(dataManager->getPendingRequests().size()));
+    return 0;
+}
@@ -0,0 +1,5 @@
+include(../bench.pri)
+
+TARGET = bench_leaveindex
+
+SOURCES += bench_leaveindex.cpp
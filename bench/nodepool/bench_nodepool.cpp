@@ -0,0 +1,68 @@
+// NodePool vs HeapNodeAllocator: heap allocations and time to reload an
+// employee list and an attendance AVL tree, and time to clear a tree.
+//   bench_nodepool [records]     (default: 1000000)
+#include "DataStructures.h"
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static const int Reloads = 3;
+static const int Employees = 2000;
+
+// Counts every heap allocation made by the program
+static long g_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template<template<typename> class NodeAllocator>
+static void run(const char* name, int records)
+{
+    AVLTree<AttendanceEntry, quint64, NodeAllocator> attendance(
+        [](const AttendanceEntry& entry) { return AttendanceKey::make(entry); });
+    DoublyLinkedList<Employee, NodeAllocator> employees;
+    const qint32 firstDay = qint32(QDate(2015, 1, 1).toJulianDay());
+    QElapsedTimer timer;
+
+    // Same shape as loadAllData(): clear both containers, then refill them
+    double reloadMs = 0;
+    long allocations = 0;
+    for (int round = 0; round < Reloads; round++) {
+        long before = g_allocations;
+        timer.start();
+        attendance.clear();
+        employees.clear();
+        for (int e = 0; e < Employees; e++) {
+            employees.insertAtEnd(Employee(1000 + e, "John Doe", "Engineering", 50000, "Developer"));
+        }
+        for (int i = 0; i < records; i++) {
+            AttendanceEntry entry = { 1000 + i % Employees, firstDay + i / Employees, 540, 1020 };
+            attendance.insert(entry);
+        }
+        reloadMs += timer.nsecsElapsed() / 1e6;
+        allocations += g_allocations - before;
+    }
+
+    timer.start();
+    attendance.clear();
+    double clearMs = timer.nsecsElapsed() / 1e6;
+
+    std::printf("%-5s %8d records | reload %7.0f ms | allocations per reload %8ld | clear %6.2f ms\n",
+                name, records, reloadMs / Reloads, allocations / Reloads, clearMs);
+}
+
+int main(int argc, char* argv[])
+{
+    int records = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    run<HeapNodeAllocator>("heap", records);
+    run<NodePool>("pool", records);
+    return 0;
+}
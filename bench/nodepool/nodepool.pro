@@ -0,0 +1,5 @@
+include(../bench.pri)
+
+TARGET = bench_nodepool
+
+SOURCES += bench_nodepool.cpp
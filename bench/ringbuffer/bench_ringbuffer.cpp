@@ -0,0 +1,41 @@
+// Pushes onto a full bounded Stack, the way an undo history drops its oldest
+// entry: linked storage walks to the bottom on every push, ring storage
+// drops the front slot.
+//   bench_ringbuffer [capacities...]     (default: 50 500 5000 20000 100000)
+#include "DataStructures.h"
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+
+// Nanoseconds per push once the stack is at capacity
+template<typename BoundedStack>
+static double perPush(int capacity, int pushes)
+{
+    BoundedStack stack(capacity);
+    Employee entry(1001, "Employee Name", "Engineering", 50000, "Developer");
+    for (int i = 0; i < capacity; i++) stack.push(entry);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < pushes; i++) {
+        entry.setId(i);
+        stack.push(entry);
+    }
+    return double(timer.nsecsElapsed()) / pushes;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<int> capacities;
+    for (int i = 1; i < argc; i++) capacities.push_back(std::atoi(argv[i]));
+    if (capacities.empty()) capacities = { 50, 500, 5000, 20000, 100000 };
+
+    for (int capacity : capacities) {
+        // Linked pushes at capacity are O(capacity); keep large runs short
+        int pushes = capacity >= 20000 ? 2000 : 20000;
+        std::printf("capacity %7d | linked %10.0f ns/push | ring %6.0f ns/push\n", capacity,
+                    perPush<Stack<Employee>>(capacity, pushes),
+                    perPush<Stack<Employee, RingStorage>>(capacity, pushes));
+    }
+    return 0;
+}
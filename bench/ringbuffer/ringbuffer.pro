@@ -0,0 +1,5 @@
+include(../bench.pri)
+
+TARGET = bench_ringbuffer
+
+SOURCES += bench_ringbuffer.cpp
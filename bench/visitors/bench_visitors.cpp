@@ -0,0 +1,63 @@
+// Per-element cost of container traversals called with a std::function
+// (the old signatures) vs a lambda taken by the template visitor overloads.
+//   bench_visitors [elements]     (default: 1000000)
+#include "DataStructures.h"
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+// Nanoseconds per element over repeats passes of pass()
+template<typename Pass>
+static double perElement(int elements, int repeats, Pass pass)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < repeats; i++) pass();
+    return double(timer.nsecsElapsed()) / (double(elements) * repeats);
+}
+
+int main(int argc, char* argv[])
+{
+    const int elements = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const int repeats = qMax(1, 20000000 / elements);
+
+    DoublyLinkedList<int> list;
+    AVLTree<int, int> avl([](const int& value) { return value; });
+    BPlusTree<int, int> bplus([](const int& value) { return value; });
+    for (int i = 0; i < elements; i++) {
+        list.insertAtEnd(i);
+        avl.insert(i);
+        bplus.insert(i);
+    }
+
+    long sum = 0;
+    std::function<void(const int&)> function = [&sum](const int& value) { sum += value; };
+    auto lambda = [&sum](const int& value) { sum += value; };
+    std::function<bool(const int&)> isLastFunction = [elements](const int& value) { return value == elements - 1; };
+    auto isLastLambda = [elements](const int& value) { return value == elements - 1; };
+
+    std::printf("%d elements, ns per element   std::function   template\n", elements);
+    std::printf("DoublyLinkedList::traverseForward   %8.2f   %8.2f\n",
+                perElement(elements, repeats, [&] { list.traverseForward(function); }),
+                perElement(elements, repeats, [&] { list.traverseForward(lambda); }));
+    std::printf("DoublyLinkedList::find              %8.2f   %8.2f\n",
+                perElement(elements, repeats, [&] { sum += *list.find(isLastFunction); }),
+                perElement(elements, repeats, [&] { sum += *list.find(isLastLambda); }));
+    std::printf("AVLTree::inorderTraversal           %8.2f   %8.2f\n",
+                perElement(elements, repeats, [&] { avl.inorderTraversal(function); }),
+                perElement(elements, repeats, [&] { avl.inorderTraversal(lambda); }));
+    std::printf("AVLTree::rangeSearch                %8.2f   %8.2f\n",
+                perElement(elements, repeats, [&] { avl.rangeSearch(0, elements, function); }),
+                perElement(elements, repeats, [&] { avl.rangeSearch(0, elements, lambda); }));
+    std::printf("BPlusTree::inorderTraversal         %8.2f   %8.2f\n",
+                perElement(elements, repeats, [&] { bplus.inorderTraversal(function); }),
+                perElement(elements, repeats, [&] { bplus.inorderTraversal(lambda); }));
+
+    // A visitor returning false stops the walk
+    int visited = 0;
+    bplus.inorderTraversal([&visited](const int& value) { visited++; return value < 9; });
+    std::printf("early termination after 10 elements: visited %d\n", visited);
+
+    return sum == 0 ? 1 : 0;
+}
@@ -0,0 +1,5 @@
+include(../bench.pri)
+
+TARGET = bench_visitors
+
+SOURCES += bench_visitors.cpp
@@ -2,14 +2,15 @@
 #include <QStringList>
 
 Employee::Employee()
-    : m_id(0), m_salary(0.0)
+    : m_id(0), m_name(0), m_department(0), m_position(0), m_salary(0.0)
 {
 }
 
 Employee::Employee(int id, const QString& name, const QString& department, 
                    double salary, const QString& position)
-    : m_id(id), m_name(name), m_department(department), 
-      m_salary(salary), m_position(position)
+    : m_id(id), m_name(StringPool::getInstance().intern(name)),
+      m_department(StringPool::getInstance().intern(department)),
+      m_position(StringPool::getInstance().intern(position)), m_salary(salary)
 {
     // Default password is employee ID
     m_password = QString::number(id);
@@ -19,10 +20,10 @@ QString Employee::toFileString() const
 {
     return QString("%1|%2|%3|%4|%5|%6")
            .arg(m_id)
-           .arg(m_name)
-           .arg(m_department)
+           .arg(getName())
+           .arg(getDepartment())
            .arg(m_salary)
-           .arg(m_position)
+           .arg(getPosition())
            .arg(m_password);
 }
 
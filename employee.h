@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDate>
+#include "stringPool.h"
 
 class Employee
 {
@@ -13,18 +14,18 @@ public:
 
     // Getters
     int getId() const { return m_id; }
-    QString getName() const { return m_name; }
-    QString getDepartment() const { return m_department; }
+    QString getName() const { return StringPool::getInstance().get(m_name); }
+    QString getDepartment() const { return StringPool::getInstance().get(m_department); }
     double getSalary() const { return m_salary; }
-    QString getPosition() const { return m_position; }
+    QString getPosition() const { return StringPool::getInstance().get(m_position); }
     QString getPassword() const { return m_password; }
 
     // Setters
     void setId(int id) { m_id = id; }
-    void setName(const QString& name) { m_name = name; }
-    void setDepartment(const QString& department) { m_department = department; }
+    void setName(const QString& name) { m_name = StringPool::getInstance().intern(name); }
+    void setDepartment(const QString& department) { m_department = StringPool::getInstance().intern(department); }
     void setSalary(double salary) { m_salary = salary; }
-    void setPosition(const QString& position) { m_position = position; }
+    void setPosition(const QString& position) { m_position = StringPool::getInstance().intern(position); }
     void setPassword(const QString& password) { m_password = password; }
 
     // File operations
@@ -33,10 +34,11 @@ public:
 
 private:
     int m_id;
-    QString m_name;
-    QString m_department;
+    // Name, department and position are ids into the StringPool
+    StringPool::Id m_name;
+    StringPool::Id m_department;
+    StringPool::Id m_position;
     double m_salary;
-    QString m_position;
     QString m_password;
 };
 
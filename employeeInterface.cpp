@@ -371,7 +371,7 @@ void EmployeeInterface::setCurrentEmployee(int employeeId)
 {
     m_currentEmployeeId = employeeId;
     
-    // Load employee data using BST search (O(log n))
+    // Load employee data using AVL search (O(log n))
     Employee* emp = m_dataManager->findEmployee(employeeId);
     if (emp) {
         m_currentEmployee = *emp;
@@ -384,7 +384,7 @@ void EmployeeInterface::setCurrentEmployee(int employeeId)
 
 void EmployeeInterface::loadEmployeeData()
 {
-    // Use DataManager BST for O(log n) employee search
+    // Use DataManager AVL tree for O(log n) employee search
     Employee* emp = m_dataManager->findEmployee(m_currentEmployeeId);
     if (emp) {
         m_currentEmployee = *emp;
@@ -393,7 +393,7 @@ void EmployeeInterface::loadEmployeeData()
 
 Employee EmployeeInterface::findEmployeeById(int id)
 {
-    // Use BST search from DataManager - O(log n) complexity
+    // Use AVL search from DataManager - O(log n) complexity
     Employee* emp = m_dataManager->findEmployee(id);
     if (emp) {
         return *emp;
@@ -424,16 +424,21 @@ void EmployeeInterface::updateDashboardInfo()
     }
 }
 
+void EmployeeInterface::reportSaveError()
+{
+    QMessageBox::critical(this, "Save Error", m_dataManager->getSaveError());
+}
+
 void EmployeeInterface::loadAttendanceData()
 {
-    // Get employee attendance using AVL Tree from DataManager
-    QList<AttendanceRecord> records = m_dataManager->getEmployeeAttendance(m_currentEmployeeId);
+    // Get most recent attendance from the per-employee AVL index - O(log n)
+    AttendanceRecord record;
+    bool found = m_dataManager->getLatestAttendance(m_currentEmployeeId, record);
     
     QString lastAttendance = "Not recorded";
     QDate today = QDate::currentDate();
     
-    // Find the most recent attendance (AVL tree returns sorted by date)
-    for (const AttendanceRecord& record : records) {
+    if (found) {
         if (record.getDate() == today) {
             lastAttendance = QString("Today at %1").arg(record.getTimeIn().toString("hh:mm"));
         } else {
@@ -490,7 +495,10 @@ void EmployeeInterface::markAttendance()
     
     // Add to AVL Tree via DataManager - O(log n) with auto-balancing
     m_dataManager->addAttendanceRecord(record);
-    m_dataManager->saveAttendanceRecords();
+    // Already in the write-ahead log; fails only if it could not be written anywhere
+    if (!m_dataManager->saveAttendanceRecords()) {
+        reportSaveError();
+    }
     
     QMessageBox::information(this, "Success", 
         QString("Attendance marked successfully at %1").arg(now.time().toString("hh:mm")));
@@ -518,13 +526,28 @@ void EmployeeInterface::submitLeaveRequest()
         return;
     }
     
+    // Reject dates overlapping this employee's pending or approved leave (Interval Tree)
+    QList<LeaveRequest> overlaps = m_dataManager->getOverlappingLeaveRequests(
+        m_currentEmployeeId, m_startDateEdit->date(), m_endDateEdit->date());
+    if (!overlaps.isEmpty()) {
+        const LeaveRequest& other = overlaps.first();
+        QMessageBox::warning(this, "Overlapping Leave",
+                             QString("These dates overlap your %1 leave request from %2 to %3.")
+                                 .arg(other.getStatusString())
+                                 .arg(other.getStartDate().toString("yyyy-MM-dd"))
+                                 .arg(other.getEndDate().toString("yyyy-MM-dd")));
+        return;
+    }
+    
     LeaveRequest request(m_currentEmployeeId, m_currentEmployee.getName(),
                         m_startDateEdit->date(), m_endDateEdit->date(),
                         m_reasonEdit->text().trimmed());
     
-    // Add to DataManager Queue - FIFO processing by admin
+    // Add to DataManager pending heap - processed by admin in queue order
     m_dataManager->submitLeaveRequest(request);
-    m_dataManager->saveLeaveRequests();
+    if (!m_dataManager->saveLeaveRequests()) {
+        reportSaveError();
+    }
     
     // Clear form
     m_startDateEdit->setDate(QDate::currentDate());
@@ -590,7 +613,7 @@ void EmployeeInterface::refreshData()
     // Reload data from DataManager
     m_dataManager->loadAllData();
     
-    // Refresh employee using BST search
+    // Refresh employee using AVL search
     Employee* emp = m_dataManager->findEmployee(m_currentEmployeeId);
     if (emp) {
         m_currentEmployee = *emp;
@@ -55,6 +55,7 @@ private:
     void saveLeaveRequest(const LeaveRequest& request);
     void saveFeedback(const QString& feedback);
     void updateDashboardInfo();
+    void reportSaveError();
     
     Employee findEmployeeById(int id);
     bool hasAttendanceToday();
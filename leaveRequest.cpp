@@ -2,14 +2,14 @@
 #include <QStringList>
 
 LeaveRequest::LeaveRequest()
-    : m_employeeId(0), m_status(LeaveStatus::Pending)
+    : m_employeeId(0), m_employeeName(0), m_status(LeaveStatus::Pending)
 {
 }
 
 LeaveRequest::LeaveRequest(int employeeId, const QString& employeeName, 
                           const QDate& startDate, const QDate& endDate, 
                           const QString& reason)
-    : m_employeeId(employeeId), m_employeeName(employeeName),
+    : m_employeeId(employeeId), m_employeeName(StringPool::getInstance().intern(employeeName)),
       m_startDate(startDate), m_endDate(endDate), m_reason(reason),
       m_status(LeaveStatus::Pending)
 {
@@ -29,7 +29,7 @@ QString LeaveRequest::toFileString() const
 {
     return QString("%1|%2|%3|%4|%5|%6")
            .arg(m_employeeId)
-           .arg(m_employeeName)
+           .arg(getEmployeeName())
            .arg(m_startDate.toString("yyyy-MM-dd"))
            .arg(m_endDate.toString("yyyy-MM-dd"))
            .arg(m_reason)
@@ -42,7 +42,7 @@ LeaveRequest LeaveRequest::fromFileString(const QString& line)
     if (parts.size() >= 6) {
         LeaveRequest request;
         request.m_employeeId = parts[0].toInt();
-        request.m_employeeName = parts[1];
+        request.m_employeeName = StringPool::getInstance().intern(parts[1]);
         request.m_startDate = QDate::fromString(parts[2], "yyyy-MM-dd");
         request.m_endDate = QDate::fromString(parts[3], "yyyy-MM-dd");
         request.m_reason = parts[4];
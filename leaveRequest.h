@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDate>
+#include "stringPool.h"
 
 enum class LeaveStatus {
     Pending,
@@ -20,7 +21,7 @@ public:
 
     // Getters
     int getEmployeeId() const { return m_employeeId; }
-    QString getEmployeeName() const { return m_employeeName; }
+    QString getEmployeeName() const { return StringPool::getInstance().get(m_employeeName); }
     QDate getStartDate() const { return m_startDate; }
     QDate getEndDate() const { return m_endDate; }
     QString getReason() const { return m_reason; }
@@ -36,7 +37,7 @@ public:
 
 private:
     int m_employeeId;
-    QString m_employeeName;
+    StringPool::Id m_employeeName;  // Id into the StringPool
     QDate m_startDate;
     QDate m_endDate;
     QString m_reason;
@@ -10,9 +10,8 @@
 #include <QFont>
 #include <QFrame>
 #include <QSpacerItem>
-#include <QFile>
-#include <QTextStream>
 #include "employee.h"
+#include "DataStructures.h"
 
 LoginDialog::LoginDialog(QWidget *parent)
     : QDialog(parent), m_mode(AdminMode)
@@ -349,21 +348,14 @@ bool LoginDialog::validateAdminLogin(const QString& username, const QString& pas
 
 bool LoginDialog::validateEmployeeLogin(int employeeId, const QString& password)
 {
-    // Check against employees file
-    QFile file("employees.txt");
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        // Fallback validation for demo
+    // Check against the loaded employees: employees.txt alone misses the
+    // changes still in the write-ahead log
+    DataManager* dataManager = DataManager::getInstance();
+    if (!dataManager->hasEmployeeFiles()) {
+        // Fallback validation for demo, until anything has been saved
         return (employeeId >= 1000 && employeeId <= 9999 && password == "emp123");
     }
     
-    QTextStream in(&file);
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        Employee emp = Employee::fromFileString(line);
-        if (emp.getId() == employeeId && emp.getPassword() == password) {
-            return true;
-        }
-    }
-    
-    return false;
+    Employee* emp = dataManager->findEmployee(employeeId);
+    return emp && emp->getPassword() == password;
 }
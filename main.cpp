@@ -3,9 +3,22 @@
 #include <QCoreApplication>
 #include <QMessageBox>
 #include "mainwindow.h"
+#include "attendanceFile.h"
 
 int main(int argc, char *argv[])
 {
+    // Offline conversion of the attendance file, without the GUI:
+    //   AttendanceManagement --convert attendance.txt attendance.dat
+    // The output gets whichever format the input is not.
+    if (argc == 4 && QString(argv[1]) == "--convert") {
+        QString error;
+        if (!AttendanceFile::convert(QString::fromLocal8Bit(argv[2]), QString::fromLocal8Bit(argv[3]), error)) {
+            qCritical("%s", qPrintable(error));
+            return 1;
+        }
+        return 0;
+    }
+    
     QApplication app(argc, argv);
     
     // Set application properties
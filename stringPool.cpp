@@ -0,0 +1,37 @@
+#include "stringPool.h"
+
+StringPool& StringPool::getInstance()
+{
+    static StringPool pool;
+    return pool;
+}
+
+StringPool::StringPool()
+{
+    strings.append(QString());
+}
+
+StringPool::Id StringPool::intern(const QString& str)
+{
+    if (str.isEmpty()) return 0;
+
+    QHash<QString, Id>::const_iterator it = ids.constFind(str);
+    if (it != ids.constEnd()) return it.value();
+
+    Id id = static_cast<Id>(strings.size());
+    strings.append(str);
+    // Key the hash with the stored copy so both share one buffer
+    ids.insert(strings.last(), id);
+    return id;
+}
+
+qint64 StringPool::memoryUsage() const
+{
+    qint64 bytes = qint64(strings.capacity()) * sizeof(QString);
+    for (const QString& str : strings) {
+        bytes += qint64(str.capacity()) * sizeof(QChar);
+    }
+    // Hash nodes: key, value and the bucket pointer
+    bytes += qint64(ids.size()) * (sizeof(QString) + sizeof(Id) + sizeof(void*));
+    return bytes;
+}
@@ -0,0 +1,41 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <QString>
+#include <QHash>
+#include <QVector>
+
+// ============================================================================
+// STRING POOL - Process-wide intern table for repeated text fields
+// ============================================================================
+// Names, departments and positions repeat across thousands of rows. Records
+// store the 32-bit Id of a pooled string instead of their own QString; each
+// distinct string is kept once. Id 0 is always the empty string, so a
+// default-constructed record needs no lookup.
+// Strings are never removed, so an Id stays valid for the life of the
+// process. Not thread-safe: intern from the thread that owns the data.
+
+class StringPool {
+public:
+    typedef quint32 Id;
+
+    static StringPool& getInstance();
+
+    // Returns the Id of an equal string, adding it first if it is new
+    Id intern(const QString& str);
+
+    const QString& get(Id id) const { return strings[id]; }
+
+    int size() const { return strings.size(); }
+    qint64 memoryUsage() const;
+
+private:
+    StringPool();
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    QHash<QString, Id> ids;
+    QVector<QString> strings;
+};
+
+#endif // STRINGPOOL_H
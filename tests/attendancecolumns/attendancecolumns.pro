@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_attendancecolumns
+
+SOURCES += tst_attendancecolumns.cpp
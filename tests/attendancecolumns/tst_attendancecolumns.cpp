@@ -0,0 +1,118 @@
+#include <QtTest>
+#include "DataStructures.h"
+
+// AttendanceColumns' summing kernel (SSE2 where available) against the
+// scalar AttendanceSummary::add() path over the same records
+class TestAttendanceColumns : public QObject
+{
+    Q_OBJECT
+
+private:
+    static constexpr int Employees = 1000;
+
+    // Times of the i-th record: mostly 09:00 clock-ins, with records that
+    // have no time in, no time out, or a time out past midnight
+    static AttendanceEntry entryAt(int i, qint32 firstDay) {
+        AttendanceEntry entry = { 1 + i % Employees, firstDay + i / Employees, 540, 1020 };
+        switch (i % 11) {
+            case 3: entry.timeIn = AttendanceEntry::NoTime; entry.timeOut = AttendanceEntry::NoTime; break;
+            case 5: entry.timeOut = AttendanceEntry::NoTime; break;
+            case 7: entry.timeIn = 1380; entry.timeOut = 420; break;     // Night shift
+            case 9: entry.timeIn = 1439; entry.timeOut = 1439; break;
+            default: break;
+        }
+        return entry;
+    }
+
+    static bool sameTotals(const AttendanceSummary& a, const AttendanceSummary& b) {
+        return a.days == b.days && a.clockedInDays == b.clockedInDays &&
+               a.clockInMinutes == b.clockInMinutes && a.completeDays == b.completeDays &&
+               a.workedMinutes == b.workedMinutes;
+    }
+
+    static void fill(AttendanceColumns& columns, int records, qint32 firstDay) {
+        columns.reserve(records);
+        for (int i = 0; i < records; i++) {
+            QVERIFY(columns.append(entryAt(i, firstDay)));
+        }
+    }
+
+private slots:
+    // More records than one SIMD block (4M), all clocked in at 09:00: the
+    // lane sums of time in add up to more than 2^31 within a block
+    void fullBlockMatchesScalar() {
+        const int records = 5000000;
+        const qint32 firstDay = qint32(QDate(2010, 1, 1).toJulianDay());
+        AttendanceColumns columns;
+        columns.reserve(records);
+        AttendanceSummary expected;
+        for (int i = 0; i < records; i++) {
+            AttendanceEntry entry = { 1 + i % Employees, firstDay + i / Employees, 540, 1020 };
+            QVERIFY(columns.append(entry));
+            expected.add(entry.timeIn, entry.timeOut);
+        }
+
+        AttendanceSummary total = columns.summarize(firstDay, firstDay + records / Employees);
+        QCOMPARE(total.days, records);
+        QCOMPARE(total.clockInMinutes, qint64(records) * 540);
+        QVERIFY(sameTotals(total, expected));
+    }
+
+    void mixedTimesMatchScalar() {
+        const int records = 4500000;
+        const qint32 firstDay = qint32(QDate(2010, 1, 1).toJulianDay());
+        AttendanceColumns columns;
+        fill(columns, records, firstDay);
+
+        AttendanceSummary expected;
+        for (int i = 0; i < records; i++) {
+            AttendanceEntry entry = entryAt(i, firstDay);
+            expected.add(entry.timeIn, entry.timeOut);
+        }
+        QVERIFY(sameTotals(columns.summarize(firstDay, firstDay + records / Employees), expected));
+    }
+
+    // Day ranges whose slices start and end off a four-record boundary
+    void dayRangesMatchScalar() {
+        const int records = 200003;
+        const qint32 firstDay = qint32(QDate(2020, 1, 1).toJulianDay());
+        AttendanceColumns columns;
+        fill(columns, records, firstDay);
+
+        const int ranges[][2] = { { 0, 0 }, { 3, 17 }, { 50, 50 }, { 0, 200 }, { 199, 250 }, { 30, 20 } };
+        for (const auto& range : ranges) {
+            AttendanceSummary expected;
+            for (int i = 0; i < records; i++) {
+                AttendanceEntry entry = entryAt(i, firstDay);
+                if (entry.day >= firstDay + range[0] && entry.day <= firstDay + range[1]) {
+                    expected.add(entry.timeIn, entry.timeOut);
+                }
+            }
+            QVERIFY(sameTotals(columns.summarize(firstDay + range[0], firstDay + range[1]), expected));
+        }
+    }
+
+    void perEmployeeMatchesScalar() {
+        const int records = 100000;
+        const qint32 firstDay = qint32(QDate(2020, 1, 1).toJulianDay());
+        AttendanceColumns columns;
+        fill(columns, records, firstDay);
+
+        std::vector<AttendanceSummary> expected(Employees);
+        for (int i = 0; i < records; i++) {
+            AttendanceEntry entry = entryAt(i, firstDay);
+            expected[entry.employeeId - 1].employeeId = entry.employeeId;
+            expected[entry.employeeId - 1].add(entry.timeIn, entry.timeOut);
+        }
+
+        std::vector<AttendanceSummary> totals = columns.summarizeByEmployee(firstDay, firstDay + records / Employees);
+        QCOMPARE(int(totals.size()), Employees);
+        for (int e = 0; e < Employees; e++) {
+            QCOMPARE(totals[e].employeeId, e + 1);
+            QVERIFY(sameTotals(totals[e], expected[e]));
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(TestAttendanceColumns)
+#include "tst_attendancecolumns.moc"
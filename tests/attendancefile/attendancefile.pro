@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_attendancefile
+
+SOURCES += tst_attendancefile.cpp
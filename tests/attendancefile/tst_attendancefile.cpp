@@ -0,0 +1,188 @@
+#include <QtTest>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtEndian>
+#include "attendanceFile.h"
+
+// Binary and text attendance base files, and the offline converter between
+// them: whatever one format holds must come back unchanged from the other
+class TestAttendanceFile : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dir;
+
+    QString path(const QString& fileName) const { return m_dir.filePath(fileName); }
+
+    static AttendanceEntry entry(int employeeId, const QDate& date, quint16 timeIn, quint16 timeOut) {
+        AttendanceEntry result = { employeeId, qint32(date.toJulianDay()), timeIn, timeOut };
+        return result;
+    }
+
+    // Complete days, a day without a time out, and one without any times
+    static AttendanceFile::Contents sample() {
+        AttendanceFile::Contents contents;
+        QDate day(2024, 2, 28);
+        contents.entries.push_back(entry(1001, day, 540, 1050));
+        contents.entries.push_back(entry(1002, day, 0, 1439));
+        contents.entries.push_back(entry(1001, day.addDays(1), 555, AttendanceEntry::NoTime));
+        contents.entries.push_back(entry(1003, day.addDays(2), AttendanceEntry::NoTime, AttendanceEntry::NoTime));
+        contents.names.insert(1001, "Ada Lovelace");
+        contents.names.insert(1002, "Alan Turing");
+        contents.names.insert(1003, "Grace Hopper");
+        contents.sequence = 12345;
+        return contents;
+    }
+
+    static bool sameContents(const AttendanceFile::Contents& a, const AttendanceFile::Contents& b) {
+        if (a.sequence != b.sequence || a.names != b.names || a.entries.size() != b.entries.size()) return false;
+        for (size_t i = 0; i < a.entries.size(); i++) {
+            const AttendanceEntry& x = a.entries[i];
+            const AttendanceEntry& y = b.entries[i];
+            if (x.employeeId != y.employeeId || x.day != y.day || x.timeIn != y.timeIn || x.timeOut != y.timeOut) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static QByteArray readFile(const QString& fileName) {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    static bool writeFile(const QString& fileName, const QByteArray& bytes) {
+        QFile file(fileName);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(bytes) == bytes.size();
+    }
+
+private slots:
+    void initTestCase() {
+        QVERIFY(m_dir.isValid());
+    }
+
+    void binaryThroughText() {
+        AttendanceFile::Contents original = sample();
+        QVERIFY(AttendanceFile::writeBinary(path("original.dat"), original));
+
+        QString error;
+        QVERIFY(AttendanceFile::convert(path("original.dat"), path("converted.txt"), error));
+        QVERIFY(AttendanceFile::convert(path("converted.txt"), path("converted.dat"), error));
+        QVERIFY(error.isEmpty());
+
+        AttendanceFile::Contents converted;
+        QVERIFY(AttendanceFile::readBinary(path("converted.dat"), converted));
+        QVERIFY(sameContents(converted, original));
+    }
+
+    void textThroughBinary() {
+        QByteArray text =
+            "#checkpoint|77\n"
+            "1001|Ada Lovelace|2024-02-28|09:00|17:30\n"
+            "1002|Alan Turing|2024-02-28|00:00|23:59\n"
+            "1001|Ada Lovelace|2024-02-29|09:15|\n"
+            "1003|Grace Hopper|2024-03-01||\n";
+        QVERIFY(writeFile(path("original.txt"), text));
+
+        QString error;
+        QVERIFY(AttendanceFile::convert(path("original.txt"), path("text.dat"), error));
+        QVERIFY(AttendanceFile::convert(path("text.dat"), path("text.txt"), error));
+        QCOMPARE(readFile(path("text.txt")), text);
+
+        AttendanceFile::Contents contents;
+        QVERIFY(AttendanceFile::readBinary(path("text.dat"), contents));
+        QCOMPARE(contents.sequence, quint64(77));
+        QCOMPARE(int(contents.entries.size()), 4);
+        QCOMPARE(contents.names.value(1003), QString("Grace Hopper"));
+    }
+
+    // Names are stored as UTF-8 with a byte length, not a character count
+    void binaryNamesKeepUtf8() {
+        AttendanceFile::Contents original = sample();
+        original.names.insert(1001, QString::fromUtf8("Zo\xc3\xab \xc4\x8c" "apek"));
+        original.names.insert(1002, QString());
+        QVERIFY(AttendanceFile::writeBinary(path("names.dat"), original));
+
+        AttendanceFile::Contents read;
+        QVERIFY(AttendanceFile::readBinary(path("names.dat"), read));
+        QVERIFY(sameContents(read, original));
+    }
+
+    void emptyContents() {
+        AttendanceFile::Contents original;
+        original.sequence = 9;
+        QVERIFY(AttendanceFile::writeBinary(path("empty.dat"), original));
+
+        QString error;
+        QVERIFY(AttendanceFile::convert(path("empty.dat"), path("empty.txt"), error));
+        QVERIFY(AttendanceFile::convert(path("empty.txt"), path("empty2.dat"), error));
+
+        AttendanceFile::Contents converted;
+        QVERIFY(AttendanceFile::readBinary(path("empty2.dat"), converted));
+        QVERIFY(sameContents(converted, original));
+    }
+
+    // A later version may make records longer; version 1 readers step over
+    // the extra bytes
+    void longerRecordsAreSkippedOver() {
+        AttendanceFile::Contents original = sample();
+        const int recordSize = 16;
+        QByteArray bytes(24 + int(original.entries.size()) * recordSize, '\0');
+        uchar* data = reinterpret_cast<uchar*>(bytes.data());
+        memcpy(data, "EASA", 4);
+        qToLittleEndian<quint16>(1, data + 4);
+        qToLittleEndian<quint16>(recordSize, data + 6);
+        qToLittleEndian<quint64>(original.sequence, data + 8);
+        qToLittleEndian<quint32>(quint32(original.entries.size()), data + 16);
+        qToLittleEndian<quint32>(1, data + 20);
+        uchar* record = data + 24;
+        for (const AttendanceEntry& entry : original.entries) {
+            qToLittleEndian<qint32>(entry.employeeId, record);
+            qToLittleEndian<qint32>(entry.day, record + 4);
+            qToLittleEndian<quint16>(entry.timeIn, record + 8);
+            qToLittleEndian<quint16>(entry.timeOut, record + 10);
+            memset(record + 12, 0xAB, recordSize - 12);
+            record += recordSize;
+        }
+        char name[8 + 3];
+        qToLittleEndian<qint32>(1001, name);
+        qToLittleEndian<quint32>(3, name + 4);
+        memcpy(name + 8, "Ada", 3);
+        bytes.append(name, sizeof(name));
+        QVERIFY(writeFile(path("longer.dat"), bytes));
+
+        AttendanceFile::Contents read;
+        QVERIFY(AttendanceFile::readBinary(path("longer.dat"), read));
+        original.names.clear();
+        original.names.insert(1001, "Ada");
+        QVERIFY(sameContents(read, original));
+    }
+
+    void convertReportsErrors() {
+        QString error;
+        QVERIFY(!AttendanceFile::convert(path("missing.dat"), path("out.txt"), error));
+        QVERIFY(error.contains("missing.dat"));
+
+        // Header claims more records than the file holds
+        QVERIFY(AttendanceFile::writeBinary(path("whole.dat"), sample()));
+        QVERIFY(writeFile(path("truncated.dat"), readFile(path("whole.dat")).left(24 + 12)));
+        error.clear();
+        QVERIFY(!AttendanceFile::convert(path("truncated.dat"), path("out.txt"), error));
+        QVERIFY(error.contains("truncated.dat"));
+
+        QByteArray newer = readFile(path("whole.dat"));
+        newer[4] = char(AttendanceFile::Version + 1);
+        QVERIFY(writeFile(path("newer.dat"), newer));
+        error.clear();
+        QVERIFY(!AttendanceFile::convert(path("newer.dat"), path("out.txt"), error));
+        QVERIFY(error.contains("newer.dat"));
+
+        error.clear();
+        QVERIFY(!AttendanceFile::convert(path("whole.dat"), path("no/such/dir/out.txt"), error));
+        QVERIFY(error.contains("out.txt"));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestAttendanceFile)
+#include "tst_attendancefile.moc"
@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_bulkoperations
+
+SOURCES += tst_bulkoperations.cpp
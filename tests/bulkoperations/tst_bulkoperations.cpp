@@ -0,0 +1,209 @@
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include <map>
+#include <random>
+#include "DataStructures.h"
+
+// Range erase and batch union on the AVL tree and the B+ tree against
+// std::map, and the DataManager bulk jobs built on them. The B+ tree runs
+// with four-key pages so that erasing a range empties whole subtrees and
+// repairs several levels.
+class TestBulkOperations : public QObject
+{
+    Q_OBJECT
+
+private:
+    struct Item {
+        int key;
+        int value;
+    };
+
+    typedef std::map<int, int> Model;
+    typedef AVLTree<Item, int> Avl;
+    typedef BPlusTree<Item, int, 4, 4> SmallPageTree;
+
+    QTemporaryDir m_dataDir;
+
+    static int keyOf(const Item& item) { return item.key; }
+
+    template<typename Tree>
+    static bool sameContents(const Tree& tree, const Model& model) {
+        if (tree.size() != static_cast<int>(model.size())) return false;
+        Model::const_iterator expected = model.begin();
+        for (const Item& item : tree) {
+            if (expected == model.end() || item.key != expected->first || item.value != expected->second) {
+                return false;
+            }
+            ++expected;
+        }
+        return expected == model.end();
+    }
+
+    static std::vector<Item> randomBatch(std::mt19937& random, int size, int keyRange) {
+        std::vector<Item> batch;
+        for (int i = 0; i < size; i++) {
+            batch.push_back(Item{ int(random() % keyRange), int(random() % 1000) });
+        }
+        return batch;
+    }
+
+    static void applyBatch(Model& model, const std::vector<Item>& batch) {
+        for (const Item& item : batch) {
+            model[item.key] = item.value;
+        }
+    }
+
+    static int eraseFromModel(Model& model, int low, int high) {
+        int removed = 0;
+        for (Model::iterator it = model.lower_bound(low); it != model.end() && it->first <= high; removed++) {
+            it = model.erase(it);
+        }
+        return removed;
+    }
+
+    // Interleaves unions, single-key changes and range erases of random
+    // widths, comparing with the model after every step
+    template<typename Tree>
+    static void runAgainstModel(Tree& tree, unsigned seed) {
+        std::mt19937 random(seed);
+        Model model;
+        for (int round = 0; round < 200; round++) {
+            switch (random() % 4) {
+                case 0: {
+                    std::vector<Item> batch = randomBatch(random, random() % 2 ? 5 : 2000, 20000);
+                    tree.unionWith(batch);
+                    applyBatch(model, batch);
+                    break;
+                }
+                case 1:
+                    for (int i = 0; i < 50; i++) {
+                        Item item = { int(random() % 20000), int(random() % 1000) };
+                        tree.insert(item);
+                        model[item.key] = item.value;
+                        int gone = int(random() % 20000);
+                        QCOMPARE(tree.remove(gone), model.erase(gone) == 1);
+                    }
+                    break;
+                default: {
+                    int low = int(random() % 21000);
+                    int high = low + int(random() % (random() % 4 ? 400 : 20000));
+                    int expected = eraseFromModel(model, low, high);
+                    QCOMPARE(tree.eraseRange(low, high), expected);
+                    break;
+                }
+            }
+            QVERIFY(sameContents(tree, model));
+        }
+    }
+
+private slots:
+    void initTestCase() {
+        QVERIFY(m_dataDir.isValid());
+        QVERIFY(QDir::setCurrent(m_dataDir.path()));
+    }
+
+    void avlMatchesModel() {
+        for (unsigned seed = 1; seed <= 3; seed++) {
+            Avl tree(keyOf);
+            runAgainstModel(tree, seed);
+            QVERIFY(tree.isBalanced());
+        }
+    }
+
+    void bplusTreeMatchesModel() {
+        for (unsigned seed = 1; seed <= 3; seed++) {
+            SmallPageTree tree(keyOf);
+            runAgainstModel(tree, seed);
+        }
+    }
+
+    // Emptying a tree, or all but its ends, leaves a usable tree
+    void bplusTreeEraseEverything() {
+        SmallPageTree tree(keyOf);
+        std::vector<Item> items;
+        for (int key = 0; key < 5000; key++) {
+            items.push_back(Item{ key, key });
+        }
+        tree.bulkLoad(items);
+        QCOMPARE(tree.eraseRange(1, 4998), 4998);
+        QCOMPARE(tree.size(), 2);
+        QCOMPARE(tree.getHeight(), 1);
+        QVERIFY(tree.search(0) && tree.search(4999));
+
+        QCOMPARE(tree.eraseRange(-10, 10000), 2);
+        QVERIFY(tree.isEmpty());
+        QCOMPARE(tree.getHeight(), 0);
+        QVERIFY(tree.begin() == tree.end());
+
+        tree.unionWith(items);
+        QCOMPARE(tree.size(), 5000);
+        QCOMPARE(tree.eraseRange(20, 10), 0);
+    }
+
+    // Equal keys take the batch value, the last one within the batch
+    void unionTakesBatchValues() {
+        std::vector<Item> batch = { { 5, 1 }, { 3, 1 }, { 5, 2 }, { 9, 1 } };
+        Avl avl(keyOf);
+        SmallPageTree bplus(keyOf);
+        for (int key = 0; key < 10; key++) {
+            avl.insert(Item{ key, 0 });
+            bplus.insert(Item{ key, 0 });
+        }
+        avl.unionWith(batch);
+        bplus.unionWith(batch);
+        Model model = { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 1 }, { 4, 0 }, { 5, 2 }, { 6, 0 }, { 7, 0 }, { 8, 0 }, { 9, 1 } };
+        QVERIFY(sameContents(avl, model));
+        QVERIFY(sameContents(bplus, model));
+    }
+
+    // Purge and import reach every attendance store: the date-ordered B+
+    // tree, the recent per-employee AVL window and the archived history;
+    // after a reload, the logged jobs give the same result
+    void purgeAndImportThroughDataManager() {
+        DataManager* dataManager = DataManager::getInstance();
+        dataManager->loadAllData();
+        QDate today = QDate::currentDate();
+        QDate first = today.addDays(-299);
+
+        QList<AttendanceRecord> records;
+        for (int day = 0; day < 300; day++) {
+            for (int employeeId = 4001; employeeId <= 4003; employeeId++) {
+                records.append(AttendanceRecord(employeeId, "Bulk Employee", first.addDays(day), QTime(9, 0), QTime(17, 0)));
+            }
+        }
+        dataManager->importAttendanceRecords(records);
+        QCOMPARE(dataManager->getAttendanceByDateRange(first, today).size(), 900);
+        QCOMPARE(dataManager->getEmployeeAttendance(4002).size(), 300);
+
+        // Re-importing a day replaces its records instead of adding to them
+        QList<AttendanceRecord> again;
+        again.append(AttendanceRecord(4001, "Bulk Employee", first.addDays(10), QTime(8, 0), QTime(12, 0)));
+        dataManager->importAttendanceRecords(again);
+        QCOMPARE(dataManager->getEmployeeAttendance(4001).size(), 300);
+
+        // Across the archive boundary
+        QDate archive = dataManager->getAttendanceArchiveDate();
+        QVERIFY(archive > first && archive < today);
+        QDate purgeStart = archive.addDays(-20);
+        QDate purgeEnd = archive.addDays(19);
+        QCOMPARE(dataManager->purgeAttendance(purgeStart, purgeEnd), 120);
+        QCOMPARE(dataManager->purgeAttendance(purgeStart, purgeEnd), 0);
+
+        for (int pass = 0; pass < 2; pass++) {
+            QCOMPARE(dataManager->getAttendanceByDateRange(first, today).size(), 780);
+            QVERIFY(dataManager->getAttendanceByDateRange(purgeStart, purgeEnd).isEmpty());
+            QCOMPARE(dataManager->getEmployeeAttendance(4003).size(), 260);
+            QCOMPARE(dataManager->getEmployeeAttendanceByDateRange(4003, purgeStart.addDays(-1), purgeEnd.addDays(1)).size(), 2);
+            QCOMPARE(dataManager->countEmployeeAttendance(4002, first, today), 260);
+
+            AttendanceRecord record;
+            QVERIFY(dataManager->findAttendanceRecord(4001, first.addDays(10), record));
+            QCOMPARE(record.getTimeOut(), QTime(12, 0));
+            dataManager->loadAllData();
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(TestBulkOperations)
+#include "tst_bulkoperations.moc"
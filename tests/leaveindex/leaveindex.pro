@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_leaveindex
+
+SOURCES += tst_leaveindex.cpp
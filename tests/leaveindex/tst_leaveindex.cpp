@@ -0,0 +1,54 @@
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include "DataStructures.h"
+
+// Leave requests indexed by (employee, start date) in DataManager. Older
+// leave files can hold two requests with the same key; only the first one
+// is indexed, and only indexed requests may be queued.
+class TestLeaveIndex : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dataDir;
+    DataManager* m_dataManager;
+
+private slots:
+    void initTestCase() {
+        QVERIFY(m_dataDir.isValid());
+        QVERIFY(QDir::setCurrent(m_dataDir.path()));
+        m_dataManager = DataManager::getInstance();
+    }
+
+    void processByKey() {
+        QDate start(2024, 6, 3);
+        m_dataManager->submitLeaveRequest(LeaveRequest(2401, "Kept", start, start.addDays(1), "Trip"));
+        QVERIFY(m_dataManager->processLeaveRequest(2401, start, LeaveStatus::Approved, false));
+        QVERIFY(!m_dataManager->processLeaveRequest(2401, start.addDays(1), LeaveStatus::Approved, false));
+
+        QList<LeaveRequest> requests = m_dataManager->getEmployeeLeaveRequests(2401);
+        QCOMPARE(requests.size(), 1);
+        QVERIFY(requests.first().getStatus() == LeaveStatus::Approved);
+    }
+
+    // The second copy is never queued, so it cannot hide the requests
+    // behind it once the indexed copy has been processed
+    void duplicateKeyIsNotQueued() {
+        QDate start(2024, 7, 1);
+        int pendingBefore = m_dataManager->getPendingRequests().size();
+        m_dataManager->submitLeaveRequest(LeaveRequest(2501, "First Copy", start, start.addDays(1), "Trip"));
+        m_dataManager->submitLeaveRequest(LeaveRequest(2501, "Second Copy", start, start.addDays(2), "Trip"));
+        m_dataManager->submitLeaveRequest(LeaveRequest(2502, "Next In Line", start, start.addDays(1), "Trip"));
+        QCOMPARE(m_dataManager->getPendingRequests().size(), pendingBefore + 2);
+
+        QVERIFY(m_dataManager->processLeaveRequest(2501, start, LeaveStatus::Approved, false));
+        QCOMPARE(m_dataManager->getPendingRequests().size(), pendingBefore + 1);
+        LeaveRequest* next = m_dataManager->getNextPendingRequest();
+        QVERIFY(next);
+        QCOMPARE(next->getEmployeeId(), 2502);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestLeaveIndex)
+#include "tst_leaveindex.moc"
@@ -0,0 +1,30 @@
+# Shared settings for the unit tests: the non-GUI sources of the
+# application, built as a Qt Test console program
+QT += core concurrent testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+APP_DIR = $$PWD/..
+INCLUDEPATH += $$APP_DIR
+
+SOURCES += \
+    $$APP_DIR/employee.cpp \
+    $$APP_DIR/leaveRequest.cpp \
+    $$APP_DIR/attendanceRecord.cpp \
+    $$APP_DIR/stringPool.cpp \
+    $$APP_DIR/writeAheadLog.cpp \
+    $$APP_DIR/attendanceFile.cpp \
+    $$APP_DIR/DataStructures.cpp
+
+HEADERS += \
+    $$APP_DIR/employee.h \
+    $$APP_DIR/leaveRequest.h \
+    $$APP_DIR/attendanceRecord.h \
+    $$APP_DIR/stringPool.h \
+    $$APP_DIR/writeAheadLog.h \
+    $$APP_DIR/attendanceFile.h \
+    $$APP_DIR/DataStructures.h
@@ -0,0 +1,11 @@
+# Unit tests (Qt Test), one console program each. Run them all with:
+#   qmake tests/tests.pro && make && make check
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    attendancecolumns \
+    attendancefile \
+    bulkoperations \
+    leaveindex \
+    undo \
+    writeaheadlog
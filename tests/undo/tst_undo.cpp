@@ -0,0 +1,108 @@
+#include <QtTest>
+#include <QDir>
+#include <QTemporaryDir>
+#include "DataStructures.h"
+
+// Undo and redo round trips through DataManager's delta-encoded action logs.
+// Every change is also written to the change log, so the tests run in a
+// temporary directory; each test uses its own employee IDs.
+class TestUndo : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_dataDir;
+    DataManager* m_dataManager;
+
+    static bool sameEmployee(const Employee& a, const Employee& b) {
+        return a.getId() == b.getId() && a.getName() == b.getName() &&
+               a.getDepartment() == b.getDepartment() && a.getSalary() == b.getSalary() &&
+               a.getPosition() == b.getPosition() && a.getPassword() == b.getPassword();
+    }
+
+    static LeaveStatus statusOf(DataManager* dataManager, int employeeId) {
+        QList<LeaveRequest> requests = dataManager->getEmployeeLeaveRequests(employeeId);
+        return requests.isEmpty() ? LeaveStatus::Rejected : requests.first().getStatus();
+    }
+
+private slots:
+    void initTestCase() {
+        QVERIFY(m_dataDir.isValid());
+        QVERIFY(QDir::setCurrent(m_dataDir.path()));
+        m_dataManager = DataManager::getInstance();
+    }
+
+    void editRoundTrip() {
+        Employee original(2001, "Ada Lovelace", "Engineering", 50000, "Developer");
+        m_dataManager->addEmployee(original, false);
+        Employee edited(2001, "Ada King", "Research", 65000, "Developer");
+        QVERIFY(m_dataManager->updateEmployee(2001, edited));
+
+        QVERIFY(m_dataManager->undo());
+        QVERIFY(m_dataManager->findEmployee(2001));
+        QVERIFY(sameEmployee(*m_dataManager->findEmployee(2001), original));
+
+        QVERIFY(m_dataManager->redo());
+        QVERIFY(sameEmployee(*m_dataManager->findEmployee(2001), edited));
+    }
+
+    void idChangeRoundTrip() {
+        Employee original(2101, "Grace Hopper", "Engineering", 70000, "Architect");
+        m_dataManager->addEmployee(original, false);
+        Employee edited(2102, "Grace Hopper", "Navy", 70000, "Architect");
+        QVERIFY(m_dataManager->updateEmployee(2101, edited));
+        QVERIFY(!m_dataManager->findEmployee(2101));
+        QVERIFY(m_dataManager->findEmployee(2102));
+
+        QVERIFY(m_dataManager->undo());
+        QVERIFY(!m_dataManager->findEmployee(2102));
+        QVERIFY(m_dataManager->findEmployee(2101));
+        QVERIFY(sameEmployee(*m_dataManager->findEmployee(2101), original));
+
+        QVERIFY(m_dataManager->redo());
+        QVERIFY(!m_dataManager->findEmployee(2101));
+        QVERIFY(m_dataManager->findEmployee(2102));
+        QVERIFY(sameEmployee(*m_dataManager->findEmployee(2102), edited));
+
+        // Edits and deletes still find the employee under the new ID
+        QVERIFY(m_dataManager->deleteEmployee(2102, false));
+        QVERIFY(!m_dataManager->findEmployee(2102));
+    }
+
+    void idChangeToTakenIdIsRejected() {
+        m_dataManager->addEmployee(Employee(2151, "First", "Sales", 40000, "Clerk"), false);
+        m_dataManager->addEmployee(Employee(2152, "Second", "Sales", 40000, "Clerk"), false);
+        QVERIFY(!m_dataManager->updateEmployee(2151, Employee(2152, "First", "Sales", 40000, "Clerk")));
+        QCOMPARE(m_dataManager->findEmployee(2151)->getName(), QString("First"));
+        QCOMPARE(m_dataManager->findEmployee(2152)->getName(), QString("Second"));
+    }
+
+    void deleteRoundTrip() {
+        Employee original(2201, "Alan Turing", "Research", 80000, "Scientist");
+        m_dataManager->addEmployee(original, false);
+        QVERIFY(m_dataManager->deleteEmployee(2201));
+
+        QVERIFY(m_dataManager->undo());
+        QVERIFY(m_dataManager->findEmployee(2201));
+        QVERIFY(sameEmployee(*m_dataManager->findEmployee(2201), original));
+
+        QVERIFY(m_dataManager->redo());
+        QVERIFY(!m_dataManager->findEmployee(2201));
+    }
+
+    void leaveDecisionRoundTrip() {
+        QDate start(2024, 3, 4);
+        m_dataManager->submitLeaveRequest(LeaveRequest(2301, "Edsger Dijkstra", start, start.addDays(4), "Conference"));
+        QVERIFY(m_dataManager->processLeaveRequest(2301, start, LeaveStatus::Approved));
+        QVERIFY(statusOf(m_dataManager, 2301) == LeaveStatus::Approved);
+
+        QVERIFY(m_dataManager->undo());
+        QVERIFY(statusOf(m_dataManager, 2301) == LeaveStatus::Pending);
+
+        QVERIFY(m_dataManager->redo());
+        QVERIFY(statusOf(m_dataManager, 2301) == LeaveStatus::Approved);
+    }
+};
+
+QTEST_APPLESS_MAIN(TestUndo)
+#include "tst_undo.moc"
@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_undo
+
+SOURCES += tst_undo.cpp
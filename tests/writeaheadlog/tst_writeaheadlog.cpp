@@ -0,0 +1,181 @@
+#include <QtTest>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include "DataStructures.h"
+#include "writeAheadLog.h"
+
+// The write-ahead log on its own (framing, torn tails, checksums) and
+// through DataManager (replay after a checkpoint, fallback when the log
+// cannot be written). Each test works in its own empty directory.
+class TestWriteAheadLog : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir m_root;
+    int m_testNumber = 0;
+
+    static QByteArray readFile(const QString& fileName) {
+        QFile file(fileName);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    static bool writeFile(const QString& fileName, const QByteArray& bytes) {
+        QFile file(fileName);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(bytes) == bytes.size();
+    }
+
+    static QStringList replayAll(const QString& fileName) {
+        QStringList payloads;
+        WriteAheadLog::replay(fileName, [&payloads](quint64, const char* data, int length) {
+            payloads.append(QString::fromUtf8(data, length));
+        });
+        return payloads;
+    }
+
+    static bool appendText(WriteAheadLog& log, const QByteArray& text) {
+        return log.append(text.constData(), text.size());
+    }
+
+private slots:
+    void initTestCase() {
+        QVERIFY(m_root.isValid());
+    }
+
+    void init() {
+        QString dir = m_root.filePath(QString::number(++m_testNumber));
+        QVERIFY(QDir().mkpath(dir));
+        QVERIFY(QDir::setCurrent(dir));
+    }
+
+    void appendAndReplay() {
+        WriteAheadLog log("test.wal");
+        QVERIFY(appendText(log, "first"));
+        QVERIFY(appendText(log, "second"));
+        QVERIFY(appendText(log, ""));
+        QCOMPARE(log.entryCount(), 3);
+        QCOMPARE(log.getNextSequence(), quint64(3));
+        log.close();
+
+        QCOMPARE(replayAll("test.wal"), QStringList({ "first", "second", "" }));
+    }
+
+    // A crash in the middle of an append leaves part of an entry at the end
+    void tornTailIsCutOff() {
+        {
+            WriteAheadLog log("test.wal");
+            QVERIFY(appendText(log, "kept one"));
+            QVERIFY(appendText(log, "kept two"));
+            QVERIFY(appendText(log, "torn"));
+        }
+        QByteArray bytes = readFile("test.wal");
+        qint64 intact = bytes.size() - (16 + 4);
+        QVERIFY(writeFile("test.wal", bytes.left(int(intact) + 10)));
+        QCOMPARE(replayAll("test.wal"), QStringList({ "kept one", "kept two" }));
+
+        // Reopening cuts the file back to the intact entries, and the next
+        // entry follows them
+        WriteAheadLog log("test.wal");
+        QVERIFY(appendText(log, "after"));
+        log.close();
+        QCOMPARE(replayAll("test.wal"), QStringList({ "kept one", "kept two", "after" }));
+        QCOMPARE(QFile("test.wal").size(), intact + 16 + 5);
+    }
+
+    void checksumMismatchStopsReplay() {
+        {
+            WriteAheadLog log("test.wal");
+            QVERIFY(appendText(log, "good"));
+            QVERIFY(appendText(log, "flipped"));
+            QVERIFY(appendText(log, "unreachable"));
+        }
+        QByteArray bytes = readFile("test.wal");
+        bytes[16 + 4 + 16] = bytes[16 + 4 + 16] ^ 0x20;     // First payload byte of the second entry
+        QVERIFY(writeFile("test.wal", bytes));
+        QCOMPARE(replayAll("test.wal"), QStringList({ "good" }));
+    }
+
+    // Changes before a checkpoint are in the base files, later ones only in
+    // the log; reloading applies each exactly once
+    void replayAfterCheckpoint() {
+        DataManager* dataManager = DataManager::getInstance();
+        dataManager->loadAllData();
+        QCOMPARE(dataManager->getEmployeeCount(), 0);
+
+        QDate start(2024, 5, 6);
+        dataManager->addEmployee(Employee(3001, "Before Checkpoint", "Sales", 40000, "Clerk"), false);
+        dataManager->submitLeaveRequest(LeaveRequest(3001, "Before Checkpoint", start, start.addDays(2), "Trip"));
+        dataManager->addAttendanceRecord(AttendanceRecord(3001, "Before Checkpoint", start.addDays(-1), QTime(9, 0)));
+        dataManager->checkpoint();
+
+        dataManager->addEmployee(Employee(3002, "After Checkpoint", "Sales", 41000, "Clerk"), false);
+        QVERIFY(dataManager->processLeaveRequest(3001, start, LeaveStatus::Approved, false));
+        dataManager->addAttendanceRecord(AttendanceRecord(3002, "After Checkpoint", start.addDays(-1), QTime(8, 30)));
+        QVERIFY(dataManager->updateEmployee(3001, Employee(3001, "Renamed", "Sales", 40000, "Clerk"), false));
+
+        dataManager->loadAllData();
+        QCOMPARE(replayAll("changes.wal").size(), 4);
+        QCOMPARE(dataManager->getEmployeeCount(), 2);
+        QCOMPARE(dataManager->findEmployee(3001)->getName(), QString("Renamed"));
+        QVERIFY(dataManager->findEmployee(3002));
+
+        QList<LeaveRequest> leave = dataManager->getEmployeeLeaveRequests(3001);
+        QCOMPARE(leave.size(), 1);
+        QVERIFY(leave.first().getStatus() == LeaveStatus::Approved);
+        QCOMPARE(dataManager->getAttendanceByDateRange(start.addDays(-1), start.addDays(-1)).size(), 2);
+    }
+
+    // If the log cannot be opened, every change goes into the base files;
+    // if those cannot be written either, the error is reported until a
+    // save succeeds
+    void unwritableLogFallsBackToBaseFiles() {
+        DataManager* dataManager = DataManager::getInstance();
+        dataManager->loadAllData();     // Closes the log
+        QVERIFY(QDir().mkdir("changes.wal"));
+
+        dataManager->addEmployee(Employee(3101, "Base File Only", "Sales", 40000, "Clerk"), false);
+        QVERIFY(dataManager->getSaveError().isEmpty());
+        QVERIFY(dataManager->saveAllData());
+        dataManager->loadAllData();
+        QVERIFY(dataManager->findEmployee(3101));
+
+        QVERIFY(QFile::remove("employees.txt"));
+        QVERIFY(QDir().mkdir("employees.txt"));
+        dataManager->addEmployee(Employee(3102, "Not Saved Yet", "Sales", 40000, "Clerk"), false);
+        QVERIFY(!dataManager->getSaveError().isEmpty());
+        QVERIFY(!dataManager->saveAllData());
+
+        QVERIFY(QDir().rmdir("employees.txt"));
+        QVERIFY(dataManager->saveAllData());
+        QVERIFY(dataManager->getSaveError().isEmpty());
+        dataManager->loadAllData();
+        QVERIFY(dataManager->findEmployee(3101));
+        QVERIFY(dataManager->findEmployee(3102));
+
+        // A writable log is used again from the next change on
+        QVERIFY(QDir().rmdir("changes.wal"));
+        dataManager->addEmployee(Employee(3103, "Logged Again", "Sales", 40000, "Clerk"), false);
+        QCOMPARE(replayAll("changes.wal").size(), 1);
+    }
+    
+    // The demo employee login is only accepted before anything was saved,
+    // not whenever no employee is loaded
+    void employeeFilesOutliveTheEmployees() {
+        DataManager* dataManager = DataManager::getInstance();
+        dataManager->loadAllData();
+        QVERIFY(!dataManager->hasEmployeeFiles());
+        
+        dataManager->addEmployee(Employee(3201, "Only Employee", "Sales", 40000, "Clerk"), false);
+        QVERIFY(dataManager->deleteEmployee(3201, false));
+        QCOMPARE(dataManager->getEmployeeCount(), 0);
+        QVERIFY(dataManager->hasEmployeeFiles());
+        
+        QVERIFY(QFile::remove("changes.wal"));
+        QVERIFY(writeFile("employees.txt", QByteArray()));
+        QVERIFY(dataManager->hasEmployeeFiles());
+    }
+};
+
+QTEST_APPLESS_MAIN(TestWriteAheadLog)
+#include "tst_writeaheadlog.moc"
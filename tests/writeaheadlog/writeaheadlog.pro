@@ -0,0 +1,5 @@
+include(../tests.pri)
+
+TARGET = tst_writeaheadlog
+
+SOURCES += tst_writeaheadlog.cpp
@@ -0,0 +1,163 @@
+#include "writeAheadLog.h"
+#include <QtEndian>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static const int HeaderSize = 16;
+static const quint32 MaxEntryLength = 64 * 1024 * 1024;
+
+// Flushes Qt's buffer, then makes the OS write its cache to the device, so
+// the data survives a power loss and not only a crash of the process
+static bool syncToDisk(QFile& file)
+{
+    if (!file.flush()) return false;
+#ifdef Q_OS_WIN
+    return FlushFileBuffers(reinterpret_cast<HANDLE>(_get_osfhandle(file.handle()))) != 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+WriteAheadLog::WriteAheadLog(const QString& fileName)
+    : path(fileName), entries(0), nextSequence(0)
+{
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    close();
+}
+
+quint32 WriteAheadLog::crc32(const char* data, int length, quint32 crc)
+{
+    // Reflected polynomial 0xEDB88320, table built on first use
+    static quint32 table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        tableReady = true;
+    }
+
+    crc = ~crc;
+    for (int i = 0; i < length; ++i) {
+        crc = table[(crc ^ static_cast<quint8>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+qint64 WriteAheadLog::scan(const QByteArray& bytes, int& count, quint64& next, const Visitor* visitor)
+{
+    const char* data = bytes.constData();
+    qint64 size = bytes.size();
+    qint64 pos = 0;
+    count = 0;
+    while (size - pos >= HeaderSize) {
+        quint32 length = qFromLittleEndian<quint32>(data + pos);
+        quint32 crc = qFromLittleEndian<quint32>(data + pos + 4);
+        if (length > MaxEntryLength || size - pos - HeaderSize < length) break;
+        if (crc32(data + pos + 8, static_cast<int>(length) + 8) != crc) break;
+
+        quint64 sequence = qFromLittleEndian<quint64>(data + pos + 8);
+        if (visitor) (*visitor)(sequence, data + pos + HeaderSize, static_cast<int>(length));
+        if (sequence + 1 > next) next = sequence + 1;
+        pos += HeaderSize + length;
+        count++;
+    }
+    return pos;
+}
+
+bool WriteAheadLog::open()
+{
+    if (file.isOpen()) return true;
+
+    // Cut off a torn tail so new entries follow the last intact one
+    qint64 valid = 0;
+    entries = 0;
+    file.setFileName(path);
+    if (file.open(QIODevice::ReadOnly)) {
+        valid = scan(file.readAll(), entries, nextSequence, nullptr);
+        file.close();
+    }
+    if (!file.open(QIODevice::ReadWrite)) return false;
+    if (file.size() != valid) file.resize(valid);
+    return file.seek(valid);
+}
+
+bool WriteAheadLog::append(const char* data, int length)
+{
+    if (!open()) return false;
+
+    char header[HeaderSize];
+    qToLittleEndian<quint32>(static_cast<quint32>(length), header);
+    qToLittleEndian<quint64>(nextSequence, header + 8);
+    qToLittleEndian<quint32>(crc32(data, length, crc32(header + 8, 8)), header + 4);
+    qint64 start = file.pos();
+    if (file.write(header, HeaderSize) != HeaderSize || file.write(data, length) != length ||
+        !syncToDisk(file)) {
+        // Drop the partial entry so later appends are not hidden behind it;
+        // if that fails too, the next open() cuts it off
+        if (!file.resize(start) || !file.seek(start)) close();
+        return false;
+    }
+    nextSequence++;
+    entries++;
+    return true;
+}
+
+void WriteAheadLog::close()
+{
+    if (file.isOpen()) file.close();
+}
+
+bool WriteAheadLog::moveTo(const QString& target)
+{
+    close();
+    entries = 0;
+    if (!QFile::exists(path)) return open();
+    if (!QFile::exists(target)) {
+        if (!QFile::rename(path, target)) return false;
+        QFile renamed(target);
+        return renamed.open(QIODevice::ReadWrite) && syncToDisk(renamed) && open();
+    }
+
+    // Target still holds entries a failed checkpoint did not fold in; append
+    // after its last intact entry
+    QFile source(path);
+    QFile destination(target);
+    if (!source.open(QIODevice::ReadOnly) || !destination.open(QIODevice::ReadWrite)) {
+        return false;
+    }
+    int count = 0;
+    quint64 next = 0;
+    qint64 end = scan(destination.readAll(), count, next, nullptr);
+    QByteArray bytes = source.readAll();
+    qint64 valid = scan(bytes, count, next, nullptr);
+    if (!destination.resize(end) || !destination.seek(end) ||
+        destination.write(bytes.constData(), valid) != valid || !syncToDisk(destination)) {
+        return false;
+    }
+    destination.close();
+    source.close();
+    return QFile::remove(path) && open();
+}
+
+int WriteAheadLog::replay(const QString& fileName, const Visitor& visitor)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) return 0;
+    int count = 0;
+    quint64 next = 0;
+    scan(file.readAll(), count, next, &visitor);
+    return count;
+}
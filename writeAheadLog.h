@@ -0,0 +1,73 @@
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <QString>
+#include <QFile>
+#include <functional>
+
+// ============================================================================
+// WRITE-AHEAD LOG - Append-only binary change log with per-entry checksums
+// ============================================================================
+// Each entry is framed as
+//     quint32 length | quint32 CRC-32 | quint64 sequence | payload
+// with little-endian header fields; the CRC covers sequence and payload.
+// Sequence numbers keep rising across checkpoints, so a base file can record
+// the first entry it does not reflect. Every append is synced to disk
+// (fsync / FlushFileBuffers) before it returns. A crash can only damage
+// the tail: replay stops at the first entry whose length or checksum does
+// not match, and the next open() cuts the file back to the last intact entry.
+// The payload format belongs to the caller.
+
+class WriteAheadLog {
+public:
+    typedef std::function<void(quint64 sequence, const char* data, int length)> Visitor;
+
+    explicit WriteAheadLog(const QString& fileName);
+    ~WriteAheadLog();
+
+    // Appends one entry and syncs it to disk: one sequential write. Opens
+    // the file on first use. On failure the file is cut back to the
+    // previous entry.
+    bool append(const char* data, int length);
+
+    const QString& getFileName() const { return path; }
+
+    // Entries in the file, counted when it was opened plus those appended since
+    int entryCount() const { return entries; }
+
+    // Sequence number the next entry gets; never moves backwards
+    quint64 getNextSequence() const { return nextSequence; }
+    void advanceSequence(quint64 sequence) {
+        if (sequence > nextSequence) nextSequence = sequence;
+    }
+
+    // Moves the entries to the end of target (renaming the file when target
+    // does not exist), syncs target, and reopens the log empty, so the file
+    // always exists
+    bool moveTo(const QString& target);
+
+    void close();
+
+    // Visits the intact entries of a log file in order; returns how many
+    static int replay(const QString& fileName, const Visitor& visitor);
+
+    // CRC-32 as in zlib; pass the previous result to continue a running CRC
+    static quint32 crc32(const char* data, int length, quint32 crc = 0);
+
+private:
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    bool open();
+
+    // Length of the intact prefix of bytes; counts its entries and notes
+    // the sequence after the last one
+    static qint64 scan(const QByteArray& bytes, int& count, quint64& next, const Visitor* visitor);
+
+    QString path;
+    QFile file;
+    int entries;
+    quint64 nextSequence;
+};
+
+#endif // WRITEAHEADLOG_H